@@ -3,9 +3,17 @@ in  vec2  TexCoords;
 out vec4  color;
 
 uniform sampler2D scene;
-uniform vec2 textureDimensions;
-uniform vec2 mousePosition;
-uniform float deltaTime;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 /* uniform vec2      offsets[9]; */
 /* uniform int       edge_kernel[9]; */
 /* uniform float     blur_kernel[9]; */
@@ -15,8 +23,8 @@ uniform bool chaos;
 uniform bool confuse;
 uniform bool shake;
 
-vec2 currentPos = gl_FragCoord.xy / textureDimensions.xy;
-vec2 mousePos = mousePosition.xy / textureDimensions.xy;
+vec2 currentPos = gl_FragCoord.xy / canvasSize.xy;
+vec2 mousePos = mousePosition.xy / canvasSize.xy;
 
 // Plot a line on Y using a value between 0.0-1.0
 float plot(vec2 st, float pct){
@@ -99,8 +107,8 @@ void main()
     /* color.x = 0; */
 
     color = texture(scene, TexCoords);
-    /* vec2 currentPos = gl_FragCoord.xy / textureDimensions.xy; */
-    /* vec2 mousePos = mousePosition.xy / textureDimensions.xy; */
+    /* vec2 currentPos = gl_FragCoord.xy / canvasSize.xy; */
+    /* vec2 mousePos = mousePosition.xy / canvasSize.xy; */
     color.xyz -= mousePos.y;
     color.xyz += mousePos.x;
     if (currentPos.y == mousePos.y)
@@ -8,7 +8,16 @@ out vec2 TexCoords;
 uniform bool  chaos;
 uniform bool  confuse;
 uniform bool  shake;
-uniform float time;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
 
 
 void main()
@@ -19,7 +28,7 @@ void main()
   if(chaos)
     {
       float strength = 0.3;
-      vec2 pos = vec2(texture.x + sin(time) * strength, texture.y + cos(time) * strength);
+      vec2 pos = vec2(texture.x + sin(timeElapsed) * strength, texture.y + cos(timeElapsed) * strength);
       TexCoords = pos;
     }
   else if(confuse)
@@ -33,7 +42,7 @@ void main()
   if (shake)
     {
       float strength = 0.02;
-      gl_Position.x += cos(time * 10) * strength;
-      gl_Position.y += cos(time * 15) * strength;
+      gl_Position.x += cos(timeElapsed * 10) * strength;
+      gl_Position.y += cos(timeElapsed * 15) * strength;
     }
 }
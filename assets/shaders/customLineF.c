@@ -3,7 +3,17 @@
 out vec4 color;
 
 uniform vec4 lineColor;
-uniform float deltaTime;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 
 void main()
 {
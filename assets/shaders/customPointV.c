@@ -4,7 +4,17 @@ layout (location = 0) in vec2 vertex; //vec2 pos, vec texcoord
 
 
 
-uniform mat4 projection;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 
 void main()
 {
@@ -5,7 +5,17 @@ out vec4 color;
 
 uniform sampler2D image;
 uniform vec4 spriteColor;
-uniform float deltaTime;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 uniform vec2 spriteDimensions;
 
 vec2 currentPos = gl_FragCoord.xy / spriteDimensions.xy;
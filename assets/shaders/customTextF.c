@@ -4,7 +4,16 @@ out vec4 color;
 
 uniform sampler2D text;
 uniform vec4 textColor;
-uniform float deltaTime;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
 
 
 void main()
@@ -7,9 +7,17 @@ out vec4 colorOUT;
 uniform sampler2D image;
 
 uniform vec4 color;
-uniform float deltaTime;
-uniform float timeElapsed;
-uniform vec2 windowDimensions;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 uniform float circleBorder;
 
 
@@ -26,7 +34,7 @@ void main()
 {
     /* HALF */
     /* if (gl_FragCoord.x > 640.0) */
-    /* if (gl_FragCoord.x > windowDimensions.x/2) */
+    /* if (gl_FragCoord.x > canvasSize.x/2) */
     /* if (gl_FragCoord.x > spritePosition.x) */
     /* { */
     /*     color = vec4(1.0, 0.0, 0.0, 1.0); */
@@ -6,9 +6,17 @@ out vec4 colorOUT;
 uniform sampler2D image;
 
 uniform vec4 color;
-uniform float deltaTime;
-uniform float timeElapsed;
-uniform vec2 windowDimensions;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 uniform float circleBorder;
 
 void main()
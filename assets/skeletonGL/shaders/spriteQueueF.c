@@ -0,0 +1,24 @@
+#version 330 core
+
+in vec2 TexCoords;
+in vec4 SpriteColor;
+out vec4 colorOUT;
+
+uniform sampler2D image;
+
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
+
+void main()
+{
+  colorOUT = SpriteColor * texture(image, TexCoords);
+}
@@ -0,0 +1,30 @@
+#version 330 core
+
+layout (location = 0) in vec2 vertex; //vec2 pos
+layout (location = 1) in vec2 UVCoords;
+layout (location = 3) in mat4 instanceModel; // Instanced arrays, one entry per queued sprite
+layout (location = 7) in vec4 instanceUV;    // Texture region, left bottom right top
+layout (location = 8) in vec4 instanceColor;
+
+out vec2 TexCoords;
+out vec4 SpriteColor;
+
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
+
+void main()
+{
+    // The base quad's UVs go from 0 to 1, stretch them over the sprite's region
+    TexCoords = mix(instanceUV.xy, instanceUV.zw, UVCoords);
+    SpriteColor = instanceColor;
+    gl_Position = projection * instanceModel * vec4(vertex.xy, 0.0, 1.0);
+}
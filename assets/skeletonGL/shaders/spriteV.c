@@ -7,7 +7,17 @@ layout (location = 1) in vec2 UVCoords;
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 projection;
+// Shared by every shader, updated once per frame (see SGL_FrameUniforms)
+layout (std140) uniform SGL_FrameUniforms
+{
+    mat4 projection;
+    mat4 overlayProjection;
+    vec2 canvasSize;
+    vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+};
+
 
 void main()
 {
@@ -0,0 +1,94 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+// Batch simulation throughput benchmark, plays the same random games through a
+// BatchSimulation and one Simulation per game, checks that every step matches
+// and reports the steps per second of both.
+// Usage: snake-sgl-batch-bench [games] [steps]
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../src/batchSimulation.hpp"
+
+int main(int argc, char *argv[])
+{
+    const std::uint16_t w = 40, h = 22;
+    std::uint32_t games = (argc > 1) ? std::stoul(argv[1]) : 4096;
+    std::uint32_t steps = (argc > 2) ? std::stoul(argv[2]) : 2000;
+
+    BatchSimulation batch(games, w, h);
+    std::vector<Simulation> sims(games, Simulation(w, h));
+    std::vector<std::mt19937> moveRng(games);
+    for (std::uint32_t g = 0; g < games; ++g)
+    {
+        batch.reset(g, g);
+        sims[g].reset(g);
+        moveRng[g].seed(g);
+    }
+
+    std::vector<DIRECTION> dirs(games, DIRECTION::NO_DIRECTION);
+    std::vector<COLLISION> results(games);
+    double batchTime = 0.0, singleTime = 0.0;
+    std::uint64_t mismatches = 0;
+
+    for (std::uint32_t s = 0; s < steps; ++s)
+    {
+        // Random walk, games that die are restarted with a new seed
+        for (std::uint32_t g = 0; g < games; ++g)
+        {
+            if (!sims[g].isAlive())
+            {
+                batch.reset(g, (s * games) + g);
+                sims[g].reset((s * games) + g);
+            }
+            dirs[g] = static_cast<DIRECTION>(moveRng[g]() & 3);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        batch.step(dirs.data(), results.data());
+        auto middle = std::chrono::steady_clock::now();
+        for (std::uint32_t g = 0; g < games; ++g)
+            if (sims[g].step(dirs[g]) != results[g])
+                mismatches++;
+        auto end = std::chrono::steady_clock::now();
+
+        batchTime += std::chrono::duration<double>(middle - start).count();
+        singleTime += std::chrono::duration<double>(end - middle).count();
+
+        for (std::uint32_t g = 0; g < games; ++g)
+        {
+            vec2d a = batch.getHeadTile(g), b = sims[g].getHeadTile();
+            if (a.x != b.x || a.y != b.y || batch.getScore(g) != sims[g].getScore() || batch.isAlive(g) != sims[g].isAlive())
+                mismatches++;
+        }
+    }
+
+    // Full body and food comparison at the end
+    for (std::uint32_t g = 0; g < games; ++g)
+    {
+        for (std::uint16_t i = 0; i < sims[g].getLength(); ++i)
+            if (batch.getSegment(g, i) != sims[g].getSegment(i))
+                mismatches++;
+        for (const FoodItem &food : sims[g].getFood())
+            if (!batch.hasFood(g, food.tile))
+                mismatches++;
+    }
+
+    double total = static_cast<double>(games) * steps;
+    std::cout << "\nBoard: " << w << " x " << h << " tiles, " << games << " games, " << steps << " steps\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "BatchSimulation (" << BatchSimulation::getKernelName() << "): " << (total / batchTime) / 1e6 << " M steps / second\n";
+    std::cout << "Simulation:               " << (total / singleTime) / 1e6 << " M steps / second\n";
+    std::cout << "Mismatches:               " << mismatches << "\n";
+
+    return (mismatches == 0) ? 0 : 1;
+}
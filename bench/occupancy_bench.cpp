@@ -0,0 +1,83 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+// Grid tick cost microbenchmark, drives the snake along a hamiltonian cycle until it
+// fills the board and reports the average cost of a move per snake length bucket.
+// Moves that eat (grow, respawn food and log) are reported apart from plain moves.
+// No window or OpenGL context is required.
+
+#include <chrono>
+#include <iomanip>
+#include "../src/grid.hpp"
+
+// Hamiltonian cycle over an even width board, row 0 is the way back to the start
+static DIRECTION cycleDirection(int x, int y, int w, int h)
+{
+    if (y == 0)
+        return (x > 0) ? DIRECTION::LEFT : DIRECTION::DOWN;
+    if (x % 2 == 0)
+        return (y == h - 1) ? DIRECTION::RIGHT : DIRECTION::DOWN;
+    if (x == w - 1)
+        return DIRECTION::UP;
+    return (y == 1) ? DIRECTION::RIGHT : DIRECTION::UP;
+}
+
+int main(int argc, char *argv[])
+{
+    const int w = 40, h = 22, tileSize = 16, buckets = 10;
+    const int tiles = w * h;
+    SGL_Texture texture; // Empty texture, the grid never touches OpenGL while updating
+
+    Grid grid(0, 0, w, h, tileSize, SGL_Color(1.0f, 1.0f, 1.0f, 1.0f), texture);
+    grid.resetGame(1);
+
+    std::vector<double> bucketTime(buckets, 0.0), bucketEatTime(buckets, 0.0);
+    std::vector<std::uint32_t> bucketMoves(buckets, 0), bucketEats(buckets, 0);
+
+    while (grid.getScore() + 1 < tiles)
+    {
+        vec2d head = grid.getHeadTile();
+        std::uint32_t score = grid.getScore();
+        grid.moveSnake(cycleDirection(head.x, head.y, w, h));
+
+        // The grid moves once every (60 / speed) updates, time the whole move
+        auto start = std::chrono::steady_clock::now();
+        grid.update();
+        grid.update();
+        auto end = std::chrono::steady_clock::now();
+
+        int bucket = ((score + 1) * buckets) / (tiles + 1);
+        double elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+        if (grid.getScore() != score)
+        {
+            bucketEatTime[bucket] += elapsed;
+            bucketEats[bucket]++;
+        }
+        else
+        {
+            bucketTime[bucket] += elapsed;
+            bucketMoves[bucket]++;
+        }
+    }
+
+    std::cout << "\nBoard: " << w << " x " << h << " tiles\n";
+    std::cout << "Snake length      Moves     ns / move      Eats      ns / eat\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (int i = 0; i < buckets; ++i)
+    {
+        std::cout << std::setw(5) << ((i * tiles) / buckets) + 1 << " - " << std::setw(5) << (((i + 1) * tiles) / buckets)
+                  << std::setw(10) << bucketMoves[i]
+                  << std::setw(14) << (bucketMoves[i] ? bucketTime[i] / bucketMoves[i] : 0.0)
+                  << std::setw(10) << bucketEats[i]
+                  << std::setw(14) << (bucketEats[i] ? bucketEatTime[i] / bucketEats[i] : 0.0) << "\n";
+    }
+
+    return 0;
+}
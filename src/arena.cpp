@@ -0,0 +1,349 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <stdexcept>
+#include <algorithm>
+#include "arena.hpp"
+
+// Out of class definitions, std::fill and friends take them by reference
+const std::uint16_t Arena::NO_OWNER;
+const std::uint32_t Arena::NO_TARGET;
+
+Arena::Arena(std::uint16_t xTiles, std::uint16_t yTiles, std::uint32_t snakes)
+{
+    if (xTiles == 0 || yTiles == 0 || xTiles > Simulation::MAX_SIDE || yTiles > Simulation::MAX_SIDE)
+        throw std::invalid_argument("Arena::Arena | Both sides of the board must be between 1 and 4096 tiles");
+    // Half the board at most, leaves room to move and to place the food
+    if (snakes == 0 || snakes >= NO_OWNER || snakes > (static_cast<std::uint32_t>(xTiles) * yTiles) / 2)
+        throw std::invalid_argument("Arena::Arena | Too many snakes for the board");
+
+    pXTiles = xTiles;
+    pYTiles = yTiles;
+    pChunksX = (xTiles + Simulation::CHUNK_SIZE - 1) >> Simulation::CHUNK_SHIFT;
+    pChunksY = (yTiles + Simulation::CHUNK_SIZE - 1) >> Simulation::CHUNK_SHIFT;
+
+    std::uint32_t tiles = static_cast<std::uint32_t>(xTiles) * yTiles;
+    pOccupancy.resize(tiles);
+    pOwner.resize(tiles);
+    pChunkCount.resize(static_cast<std::size_t>(pChunksX) * pChunksY);
+    pFreeTiles.resize(tiles);
+    pFreeTileSlot.resize(tiles);
+
+    pNextSegment.resize(tiles);
+    pPrevSegment.resize(tiles);
+    pSnakes.resize(snakes);
+    pTargets.resize(snakes);
+    pClaims.reserve(snakes);
+    pDying.reserve(snakes);
+    this->reset(0);
+}
+
+void Arena::reset(std::uint32_t seed)
+{
+    pSeed = seed;
+    pMt.seed(pSeed);
+
+    std::uint32_t tiles = static_cast<std::uint32_t>(pOccupancy.size());
+    std::fill(pOccupancy.begin(), pOccupancy.end(), CELL::EMPTY);
+    std::fill(pOwner.begin(), pOwner.end(), NO_OWNER);
+    std::fill(pChunkCount.begin(), pChunkCount.end(), 0);
+    for (std::uint32_t i = 0; i < tiles; ++i)
+    {
+        pFreeTiles[i] = i;
+        pFreeTileSlot[i] = i;
+    }
+    pFreeTileCount = tiles;
+
+    for (std::uint32_t i = 0; i < pSnakes.size(); ++i)
+    {
+        Snake &snake = pSnakes[i];
+        snake.head = pFreeTiles[randomBelow(pMt, pFreeTileCount)];
+        snake.tail = snake.head;
+        snake.length = 1;
+        snake.growth = 0;
+        snake.alive = true;
+        setTile(snake.head, CELL::HEAD, static_cast<std::uint16_t>(i));
+    }
+    pAliveCount = static_cast<std::uint32_t>(pSnakes.size());
+
+    pFood.clear();
+    respawnFood(Simulation::STARTING_FOOD + static_cast<std::uint32_t>(pSnakes.size()));
+}
+
+void Arena::step(const DIRECTION *dirs, COLLISION *results)
+{
+    pClaims.clear();
+    pDying.clear();
+
+    // Where every snake wants to go, judged against the board as it is before anyone moves
+    for (std::uint32_t i = 0; i < pSnakes.size(); ++i)
+    {
+        const Snake &snake = pSnakes[i];
+        COLLISION result = COLLISION::NO_COLLISION;
+        pTargets[i] = NO_TARGET;
+
+        if (!snake.alive)
+            result = COLLISION::SNAKE;
+        else
+        {
+            std::uint32_t current = snake.head;
+            int x = current % pXTiles, y = current / pXTiles;
+            switch (dirs[i])
+            {
+            case DIRECTION::UP:
+                y--;
+                break;
+            case DIRECTION::DOWN:
+                y++;
+                break;
+            case DIRECTION::LEFT:
+                x--;
+                break;
+            case DIRECTION::RIGHT:
+                x++;
+                break;
+            default:
+                x = -1; // Waiting for the first input, stays put
+                break;
+            }
+
+            std::uint32_t tile = (static_cast<std::uint32_t>(y) * pXTiles) + x;
+            if (dirs[i] == DIRECTION::NO_DIRECTION || dirs[i] == DIRECTION::END_ENUM)
+                result = COLLISION::NO_COLLISION;
+            else if (x < 0 || x >= pXTiles || y < 0 || y >= pYTiles)
+                result = COLLISION::WALL;
+            else if (snake.length > 1 && tile == pNextSegment[snake.head])
+                result = COLLISION::NECK;
+            else if (pOccupancy[tile] == CELL::HEAD || pOccupancy[tile] == CELL::NECK || pOccupancy[tile] == CELL::BODY)
+            {
+                result = COLLISION::SNAKE;
+                pDying.push_back(i);
+            }
+            else
+            {
+                result = (pOccupancy[tile] == CELL::FOOD) ? COLLISION::FOOD : COLLISION::NO_COLLISION;
+                pTargets[i] = tile;
+                pClaims.push_back((static_cast<std::uint64_t>(tile) << 32) | i);
+            }
+        }
+        if (results)
+            results[i] = result;
+    }
+
+    // Head-on, every snake moving into a tile claimed more than once dies
+    std::sort(pClaims.begin(), pClaims.end());
+    for (std::size_t begin = 0, end; begin < pClaims.size(); begin = end)
+    {
+        for (end = begin + 1; end < pClaims.size() && (pClaims[end] >> 32) == (pClaims[begin] >> 32); ++end)
+            ;
+        if (end - begin == 1)
+            continue;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::uint32_t snake = static_cast<std::uint32_t>(pClaims[i]);
+            pTargets[snake] = NO_TARGET;
+            pDying.push_back(snake);
+            if (results)
+                results[snake] = COLLISION::SNAKE;
+        }
+    }
+
+    // Every target is unique and was empty or food, the moves can't interfere
+    std::uint32_t eaten = 0;
+    for (std::uint32_t i = 0; i < pSnakes.size(); ++i)
+    {
+        if (pTargets[i] == NO_TARGET)
+            continue;
+        if (pOccupancy[pTargets[i]] == CELL::FOOD)
+        {
+            eatFood(pTargets[i]);
+            pSnakes[i].growth++;
+            eaten++;
+        }
+        pushHead(i, pTargets[i]);
+    }
+
+    for (std::uint32_t i : pDying)
+    {
+        Snake &snake = pSnakes[i];
+        std::uint32_t tile = snake.head;
+        for (std::uint32_t segment = 0; segment < snake.length; ++segment, tile = pNextSegment[tile])
+            setTile(tile, CELL::EMPTY, NO_OWNER);
+        snake.alive = false;
+        pAliveCount--;
+    }
+
+    respawnFood(eaten);
+}
+
+void Arena::pushHead(std::uint32_t index, std::uint32_t tile)
+{
+    Snake &snake = pSnakes[index];
+    std::uint16_t owner = static_cast<std::uint16_t>(index);
+
+    // The target was empty or food, never a tail, so its links are free to overwrite
+    pNextSegment[tile] = snake.head;
+    pPrevSegment[snake.head] = tile;
+    snake.head = tile;
+    if (snake.growth > 0)
+    {
+        snake.growth--;
+        snake.length++;
+    }
+    else
+    {
+        std::uint32_t tail = snake.tail;
+        snake.tail = pPrevSegment[tail];
+        setTile(tail, CELL::EMPTY, NO_OWNER);
+    }
+
+    if (snake.length > 1)
+        setTile(pNextSegment[tile], CELL::NECK, owner);
+    if (snake.length > 2)
+        setTile(pNextSegment[pNextSegment[tile]], CELL::BODY, owner);
+    setTile(tile, CELL::HEAD, owner);
+}
+
+void Arena::eatFood(std::uint32_t tile)
+{
+    for (auto iter = pFood.begin(); iter != pFood.end(); ++iter)
+    {
+        if (iter->tile == tile)
+        {
+            pFood.erase(iter);
+            break;
+        }
+    }
+}
+
+void Arena::setTile(std::uint32_t tile, CELL cell, std::uint16_t owner)
+{
+    std::uint32_t x = tile % pXTiles, y = tile / pXTiles;
+    std::size_t chunk = (static_cast<std::size_t>(y >> Simulation::CHUNK_SHIFT) * pChunksX) + (x >> Simulation::CHUNK_SHIFT);
+    if (pOccupancy[tile] == CELL::EMPTY && cell != CELL::EMPTY)
+    {
+        std::uint32_t last = pFreeTiles[--pFreeTileCount];
+        pFreeTiles[pFreeTileSlot[tile]] = last;
+        pFreeTileSlot[last] = pFreeTileSlot[tile];
+        pChunkCount[chunk]++;
+    }
+    else if (pOccupancy[tile] != CELL::EMPTY && cell == CELL::EMPTY)
+    {
+        pFreeTiles[pFreeTileCount] = tile;
+        pFreeTileSlot[tile] = pFreeTileCount++;
+        pChunkCount[chunk]--;
+    }
+    pOccupancy[tile] = cell;
+    pOwner[tile] = owner;
+}
+
+std::uint32_t Arena::respawnFood(std::uint32_t amount)
+{
+    for (std::uint32_t i = 0; i < amount; ++i)
+    {
+        if (pFreeTileCount == 0)
+            return i;
+
+        FoodItem food;
+        food.tile = pFreeTiles[randomBelow(pMt, pFreeTileCount)];
+        food.kind = static_cast<std::uint8_t>(randomBelow(pMt, Simulation::FOOD_KINDS));
+        pFood.push_back(food);
+        setTile(food.tile, CELL::FOOD, NO_OWNER);
+    }
+    return amount;
+}
+
+std::uint32_t Arena::getSnakeCount() const
+{
+    return static_cast<std::uint32_t>(pSnakes.size());
+}
+
+std::uint32_t Arena::getAliveCount() const
+{
+    return pAliveCount;
+}
+
+bool Arena::isAlive(std::uint32_t snake) const
+{
+    return pSnakes[snake].alive;
+}
+
+std::uint32_t Arena::getScore(std::uint32_t snake) const
+{
+    return pSnakes[snake].length - 1;
+}
+
+std::uint32_t Arena::getLength(std::uint32_t snake) const
+{
+    return pSnakes[snake].length;
+}
+
+std::uint32_t Arena::getSegment(std::uint32_t snake, std::uint32_t segment) const
+{
+    std::uint32_t tile = pSnakes[snake].head;
+    for (; segment > 0; --segment)
+        tile = pNextSegment[tile];
+    return tile;
+}
+
+vec2d Arena::getHeadTile(std::uint32_t snake) const
+{
+    std::uint32_t head = pSnakes[snake].head;
+    vec2d tile;
+    tile.x = head % pXTiles;
+    tile.y = head / pXTiles;
+    return tile;
+}
+
+std::uint32_t Arena::getSeed() const
+{
+    return pSeed;
+}
+
+std::uint16_t Arena::getXTiles() const
+{
+    return pXTiles;
+}
+
+std::uint16_t Arena::getYTiles() const
+{
+    return pYTiles;
+}
+
+CELL Arena::getCell(int x, int y) const
+{
+    return pOccupancy[(static_cast<std::size_t>(y) * pXTiles) + x];
+}
+
+std::uint16_t Arena::getOwner(int x, int y) const
+{
+    return pOwner[(static_cast<std::size_t>(y) * pXTiles) + x];
+}
+
+const std::vector<FoodItem> &Arena::getFood() const
+{
+    return pFood;
+}
+
+std::uint16_t Arena::getChunksX() const
+{
+    return pChunksX;
+}
+
+std::uint16_t Arena::getChunksY() const
+{
+    return pChunksY;
+}
+
+std::uint16_t Arena::getChunkCount(int chunkX, int chunkY) const
+{
+    return pChunkCount[(static_cast<std::size_t>(chunkY) * pChunksX) + chunkX];
+}
@@ -0,0 +1,103 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <vector>
+#include <cstdint>
+#include "simulation.hpp"
+
+// Several snakes on one board, all of them moving at once every tick. The rules are
+// Simulation's (walls stop a snake, its own neck is ignored, any body kills) plus:
+//   - Snakes collide against the board as it was when the tick started, tails included
+//   - Heads that move into the same tile die together (head-on), food there stays put
+//   - Dead snakes are cleared off the board at the end of the tick and stay dead
+class Arena
+{
+private:
+    // Bodies are linked through the tiles they cover, see pNextSegment
+    struct Snake
+    {
+        std::uint32_t head, tail; // Tile indices
+        std::uint32_t length, growth;
+        bool alive;
+    };
+
+    std::uint16_t pXTiles, pYTiles;
+    std::uint16_t pChunksX, pChunksY;
+
+    // Shared occupancy map (row major) and the snake each tile belongs to, with a count
+    // of occupied tiles per CHUNK_SIZE square chunk so empty ones can be skipped
+    std::vector<CELL> pOccupancy;
+    std::vector<std::uint16_t> pOwner;
+    std::vector<std::uint16_t> pChunkCount;
+    // Every empty tile, same swap and pop scheme as Simulation
+    std::vector<std::uint32_t> pFreeTiles, pFreeTileSlot;
+    std::uint32_t pFreeTileCount;
+    std::vector<FoodItem> pFood;
+
+    // A tile holds one segment at most, so every body fits in two links per tile no
+    // matter how many snakes share the board: the tile of the next segment towards the
+    // tail and the one towards the head. Only meaningful on tiles covered by a snake
+    std::vector<std::uint32_t> pNextSegment, pPrevSegment;
+    std::vector<Snake> pSnakes;
+    std::uint32_t pAliveCount;
+
+    // Per tick scratch, sized once: where every snake is headed and the (tile, snake)
+    // claims sorted to find head-on collisions
+    std::vector<std::uint32_t> pTargets;
+    std::vector<std::uint64_t> pClaims;
+    std::vector<std::uint32_t> pDying;
+
+    GameRandom pMt;
+    std::uint32_t pSeed;
+
+    void setTile(std::uint32_t tile, CELL cell, std::uint16_t owner);
+    void pushHead(std::uint32_t snake, std::uint32_t tile);
+    void eatFood(std::uint32_t tile);
+    std::uint32_t respawnFood(std::uint32_t amount);
+
+public:
+    static const std::uint16_t NO_OWNER = 0xFFFF;
+    static const std::uint32_t NO_TARGET = 0xFFFFFFFF;
+
+    // Throws std::invalid_argument on an invalid board or if the snakes can't fit in it
+    Arena(std::uint16_t xTiles, std::uint16_t yTiles, std::uint32_t snakes);
+
+    // Snakes start one tile long on random tiles, followed by STARTING_FOOD plus one piece per snake
+    void reset(std::uint32_t seed);
+    // Moves every snake at once, dirs holds one entry per snake. results, if given, gets
+    // one entry per snake: SNAKE for every snake that died this tick or earlier
+    void step(const DIRECTION *dirs, COLLISION *results = nullptr);
+
+    std::uint32_t getSnakeCount() const;
+    std::uint32_t getAliveCount() const;
+    bool isAlive(std::uint32_t snake) const;
+    std::uint32_t getScore(std::uint32_t snake) const;
+    std::uint32_t getLength(std::uint32_t snake) const;
+    // Tile index of a body segment, segment 0 is the head. Walks the body, linear in segment
+    std::uint32_t getSegment(std::uint32_t snake, std::uint32_t segment) const;
+    vec2d getHeadTile(std::uint32_t snake) const;
+    std::uint32_t getSeed() const;
+
+    std::uint16_t getXTiles() const;
+    std::uint16_t getYTiles() const;
+    CELL getCell(int x, int y) const;
+    // Snake on the tile, NO_OWNER for empty and food tiles
+    std::uint16_t getOwner(int x, int y) const;
+    const std::vector<FoodItem> &getFood() const;
+    std::uint16_t getChunksX() const;
+    std::uint16_t getChunksY() const;
+    std::uint16_t getChunkCount(int chunkX, int chunkY) const;
+};
+
+#endif
@@ -0,0 +1,201 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <algorithm>
+#include "autopilot.hpp"
+
+static const DIRECTION directions[4] = {DIRECTION::UP, DIRECTION::DOWN, DIRECTION::LEFT, DIRECTION::RIGHT};
+static const int directionX[4] = {0, 0, -1, 1};
+static const int directionY[4] = {-1, 1, 0, 0};
+
+Autopilot::Autopilot(std::uint16_t xTiles, std::uint16_t yTiles)
+{
+    pXTiles = xTiles;
+    pYTiles = yTiles;
+    std::uint32_t tiles = static_cast<std::uint32_t>(xTiles) * yTiles;
+    pVisited.resize((tiles + 63) / 64);
+    pFrontier.resize(tiles);
+    pCameFrom.resize(tiles);
+    pPath.reserve(tiles);
+    pSearches = 0;
+    this->reset();
+}
+
+void Autopilot::reset()
+{
+    pPath.clear();
+    pPathStep = 0;
+    pTargetTile = pExpectedHead = NO_TILE;
+}
+
+bool Autopilot::isOpen(const Simulation &sim, std::uint32_t tile) const
+{
+    CELL cell = sim.getCell(tile);
+    return cell == CELL::EMPTY || cell == CELL::FOOD;
+}
+
+void Autopilot::clearVisited()
+{
+    std::fill(pVisited.begin(), pVisited.end(), 0);
+}
+
+// Marks the tile, false if it already was
+bool Autopilot::visit(std::uint32_t tile)
+{
+    std::uint64_t bit = std::uint64_t(1) << (tile & 63);
+    if (pVisited[tile >> 6] & bit)
+        return false;
+    pVisited[tile >> 6] |= bit;
+    return true;
+}
+
+std::uint32_t Autopilot::findFood(const Simulation &sim, std::uint32_t head)
+{
+    pSearches++;
+    clearVisited();
+    visit(head);
+    pFrontier[0] = head;
+
+    // The frontier is a plain array, every tile is pushed at most once
+    std::uint32_t begin = 0, end = 1, found = NO_TILE;
+    while (begin < end && found == NO_TILE)
+    {
+        std::uint32_t tile = pFrontier[begin++];
+        int x = tile % pXTiles, y = tile / pXTiles;
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextX = x + directionX[i], nextY = y + directionY[i];
+            if (nextX < 0 || nextX >= pXTiles || nextY < 0 || nextY >= pYTiles)
+                continue;
+            std::uint32_t next = (static_cast<std::uint32_t>(nextY) * pXTiles) + nextX;
+            if (!isOpen(sim, next) || !visit(next))
+                continue;
+            pCameFrom[next] = static_cast<std::uint8_t>(i);
+            pFrontier[end++] = next;
+            if (sim.getCell(next) == CELL::FOOD)
+            {
+                found = next;
+                break;
+            }
+        }
+    }
+    if (found == NO_TILE)
+        return NO_TILE;
+
+    // Walk back to the head, the path comes out reversed
+    pPath.clear();
+    for (std::uint32_t tile = found; tile != head;)
+    {
+        int i = pCameFrom[tile];
+        pPath.push_back(directions[i]);
+        tile = ((tile / pXTiles) - directionY[i]) * pXTiles + ((tile % pXTiles) - directionX[i]);
+    }
+    std::reverse(pPath.begin(), pPath.end());
+    pPathStep = 0;
+    return found;
+}
+
+std::uint32_t Autopilot::floodFill(const Simulation &sim, std::uint32_t start, std::uint32_t limit)
+{
+    clearVisited();
+    visit(start);
+    pFrontier[0] = start;
+
+    std::uint32_t begin = 0, end = 1;
+    while (begin < end && end < limit)
+    {
+        std::uint32_t tile = pFrontier[begin++];
+        int x = tile % pXTiles, y = tile / pXTiles;
+        for (int i = 0; i < 4; ++i)
+        {
+            int nextX = x + directionX[i], nextY = y + directionY[i];
+            if (nextX < 0 || nextX >= pXTiles || nextY < 0 || nextY >= pYTiles)
+                continue;
+            std::uint32_t next = (static_cast<std::uint32_t>(nextY) * pXTiles) + nextX;
+            if (isOpen(sim, next) && visit(next))
+                pFrontier[end++] = next;
+        }
+    }
+    return end;
+}
+
+// No safe path to food, take the move with the most room behind it. Anything past twice
+// the body's length is plenty, the fills stop there
+DIRECTION Autopilot::survive(const Simulation &sim, std::uint32_t head, DIRECTION lastMove)
+{
+    DIRECTION move = lastMove;
+    std::uint32_t best = 0, limit = sim.getLength() * 2;
+    int x = head % pXTiles, y = head / pXTiles;
+    for (int i = 0; i < 4; ++i)
+    {
+        int nextX = x + directionX[i], nextY = y + directionY[i];
+        if (nextX < 0 || nextX >= pXTiles || nextY < 0 || nextY >= pYTiles)
+            continue;
+        std::uint32_t next = (static_cast<std::uint32_t>(nextY) * pXTiles) + nextX;
+        if (!isOpen(sim, next))
+            continue;
+        std::uint32_t area = floodFill(sim, next, limit);
+        if (area > best)
+        {
+            best = area;
+            move = directions[i];
+        }
+    }
+    return move;
+}
+
+DIRECTION Autopilot::nextMove(const Simulation &sim, DIRECTION lastMove)
+{
+    vec2d headTile = sim.getHeadTile();
+    std::uint32_t head = (static_cast<std::uint32_t>(headTile.y) * pXTiles) + headTile.x;
+
+    // The cached path stays good while the food is there and the snake followed it. Its
+    // tiles were open when it was found and the body only ever frees them since
+    if (head != pExpectedHead || pPathStep >= pPath.size() || sim.getCell(pTargetTile) != CELL::FOOD)
+    {
+        pTargetTile = findFood(sim, head);
+        pExpectedHead = NO_TILE;
+        if (pTargetTile == NO_TILE)
+            return survive(sim, head, lastMove);
+
+        // Enough room past the first step to fit the whole body
+        std::uint32_t first = (pPath[0] == DIRECTION::UP) ? head - pXTiles : (pPath[0] == DIRECTION::DOWN) ? head + pXTiles :
+                              (pPath[0] == DIRECTION::LEFT) ? head - 1 : head + 1;
+        if (floodFill(sim, first, sim.getLength()) < sim.getLength())
+        {
+            pTargetTile = NO_TILE;
+            return survive(sim, head, lastMove);
+        }
+    }
+
+    DIRECTION move = pPath[pPathStep++];
+    switch (move)
+    {
+    case DIRECTION::UP:
+        pExpectedHead = head - pXTiles;
+        break;
+    case DIRECTION::DOWN:
+        pExpectedHead = head + pXTiles;
+        break;
+    case DIRECTION::LEFT:
+        pExpectedHead = head - 1;
+        break;
+    default:
+        pExpectedHead = head + 1;
+        break;
+    }
+    return move;
+}
+
+std::uint64_t Autopilot::getSearches() const
+{
+    return pSearches;
+}
@@ -0,0 +1,62 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef AUTOPILOT_HPP
+#define AUTOPILOT_HPP
+
+#include <vector>
+#include <cstdint>
+#include "simulation.hpp"
+
+// Pathfinding player. A breadth first search from the head finds the closest food and the
+// path to it is followed for as long as that food stays put. Before a path is taken a flood
+// fill checks there's at least as much room past its first step as the snake is long,
+// otherwise the autopilot just heads for the largest open area. Every buffer is sized for
+// the board once, nothing is allocated while playing
+class Autopilot
+{
+private:
+    std::uint16_t pXTiles, pYTiles;
+
+    // Search scratch, the visited set is a bitset cleared before every search
+    std::vector<std::uint64_t> pVisited;
+    std::vector<std::uint32_t> pFrontier;
+    std::vector<std::uint8_t> pCameFrom; // Direction index that reached each visited tile
+
+    // Cached path, pPath[pPathStep] is the next move as long as the head is on pExpectedHead
+    std::vector<DIRECTION> pPath;
+    std::uint32_t pPathStep;
+    std::uint32_t pTargetTile, pExpectedHead;
+    std::uint64_t pSearches;
+
+    bool isOpen(const Simulation &sim, std::uint32_t tile) const;
+    void clearVisited();
+    bool visit(std::uint32_t tile);
+    // Closest food's tile or NO_TILE, fills pPath
+    std::uint32_t findFood(const Simulation &sim, std::uint32_t head);
+    // Open tiles reachable from start, stops counting at limit
+    std::uint32_t floodFill(const Simulation &sim, std::uint32_t start, std::uint32_t limit);
+    DIRECTION survive(const Simulation &sim, std::uint32_t head, DIRECTION lastMove);
+
+public:
+    static const std::uint32_t NO_TILE = 0xFFFFFFFF;
+
+    Autopilot(std::uint16_t xTiles, std::uint16_t yTiles);
+
+    // Forgets the cached path, call whenever a new game starts
+    void reset();
+    // Next move for the snake in sim, which must match the autopilot's board size
+    DIRECTION nextMove(const Simulation &sim, DIRECTION lastMove);
+    // Searches run so far, decisions that didn't need one reused the cached path
+    std::uint64_t getSearches() const;
+};
+
+#endif
@@ -0,0 +1,487 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include "batchSimulation.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Everything the vector pass reads and writes
+struct BatchKernelArgs
+{
+    const DIRECTION *dirs;
+    COLLISION *results;
+    const std::int32_t *headX, *headY, *neck, *alive;
+    std::int32_t *target;
+    const std::uint32_t *body, *food;
+    std::int32_t xTiles, yTiles, words;
+};
+
+typedef void (*BatchKernel)(const BatchKernelArgs &args, std::uint32_t begin, std::uint32_t end);
+
+static bool testBit(const std::uint32_t *board, std::int32_t words, std::uint32_t game, std::int32_t tile)
+{
+    return (board[(game * words) + (tile >> 5)] >> (tile & 31)) & 1;
+}
+
+// Reference kernel, the vector ones must match it lane for lane
+static void classifyScalar(const BatchKernelArgs &a, std::uint32_t begin, std::uint32_t end)
+{
+    for (std::uint32_t g = begin; g < end; ++g)
+    {
+        if (!a.alive[g])
+        {
+            a.results[g] = COLLISION::SNAKE;
+            continue;
+        }
+
+        std::int32_t x = a.headX[g], y = a.headY[g];
+        switch (a.dirs[g])
+        {
+        case DIRECTION::UP:
+            y--;
+            break;
+        case DIRECTION::DOWN:
+            y++;
+            break;
+        case DIRECTION::LEFT:
+            x--;
+            break;
+        case DIRECTION::RIGHT:
+            x++;
+            break;
+        default:
+            a.results[g] = COLLISION::NO_COLLISION; // Waiting for the first input
+            continue;
+        }
+
+        if (x < 0 || x >= a.xTiles || y < 0 || y >= a.yTiles)
+        {
+            a.results[g] = COLLISION::WALL;
+            continue;
+        }
+
+        std::int32_t tile = (y * a.xTiles) + x;
+        a.target[g] = tile;
+        if (tile == a.neck[g])
+            a.results[g] = COLLISION::NECK;
+        else if (testBit(a.body, a.words, g, tile))
+            a.results[g] = COLLISION::SNAKE;
+        else if (testBit(a.food, a.words, g, tile))
+            a.results[g] = COLLISION::FOOD;
+        else
+            a.results[g] = COLLISION::NO_COLLISION;
+    }
+}
+
+#ifdef BATCH_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void classifySSE41(const BatchKernelArgs &a, std::uint32_t begin, std::uint32_t end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maxX = _mm_set1_epi32(a.xTiles - 1), maxY = _mm_set1_epi32(a.yTiles - 1);
+    const __m128i width = _mm_set1_epi32(a.xTiles);
+    alignas(16) std::int32_t tiles[4], bodyHits[4], foodHits[4], codes[4];
+
+    std::uint32_t g = begin;
+    for (; g + 4 <= end; g += 4)
+    {
+        std::int32_t raw;
+        std::memcpy(&raw, a.dirs + g, 4);
+        __m128i dir = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(raw));
+
+        // Direction application, the compares return -1 for true
+        __m128i dx = _mm_sub_epi32(_mm_cmpeq_epi32(dir, _mm_set1_epi32(2)), _mm_cmpeq_epi32(dir, _mm_set1_epi32(3)));
+        __m128i dy = _mm_sub_epi32(_mm_cmpeq_epi32(dir, _mm_set1_epi32(0)), _mm_cmpeq_epi32(dir, _mm_set1_epi32(1)));
+        __m128i x = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a.headX + g)), dx);
+        __m128i y = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a.headY + g)), dy);
+
+        // Wall tests
+        __m128i wall = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(zero, x), _mm_cmpgt_epi32(x, maxX)),
+                                    _mm_or_si128(_mm_cmpgt_epi32(zero, y), _mm_cmpgt_epi32(y, maxY)));
+        __m128i tile = _mm_andnot_si128(wall, _mm_add_epi32(_mm_mullo_epi32(y, width), x));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a.target + g), tile);
+
+        // No gathers below AVX2, the bitboards are read one lane at a time
+        _mm_store_si128(reinterpret_cast<__m128i *>(tiles), tile);
+        for (int i = 0; i < 4; ++i)
+        {
+            bodyHits[i] = -static_cast<std::int32_t>(testBit(a.body, a.words, g + i, tiles[i]));
+            foodHits[i] = -static_cast<std::int32_t>(testBit(a.food, a.words, g + i, tiles[i]));
+        }
+        __m128i neck = _mm_cmpeq_epi32(tile, _mm_loadu_si128(reinterpret_cast<const __m128i *>(a.neck + g)));
+        __m128i noDir = _mm_or_si128(_mm_cmpgt_epi32(dir, _mm_set1_epi32(3)), _mm_cmpgt_epi32(zero, dir));
+        __m128i dead = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a.alive + g)), zero);
+
+        // Resolve in the same priority as the scalar kernel, last blend wins
+        __m128i code = _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i *>(foodHits)), _mm_set1_epi32(static_cast<int>(COLLISION::FOOD)));
+        code = _mm_blendv_epi8(code, _mm_set1_epi32(static_cast<int>(COLLISION::SNAKE)), _mm_load_si128(reinterpret_cast<const __m128i *>(bodyHits)));
+        code = _mm_blendv_epi8(code, _mm_set1_epi32(static_cast<int>(COLLISION::NECK)), neck);
+        code = _mm_blendv_epi8(code, _mm_set1_epi32(static_cast<int>(COLLISION::WALL)), wall);
+        code = _mm_andnot_si128(noDir, code);
+        code = _mm_blendv_epi8(code, _mm_set1_epi32(static_cast<int>(COLLISION::SNAKE)), dead);
+
+        _mm_store_si128(reinterpret_cast<__m128i *>(codes), code);
+        for (int i = 0; i < 4; ++i)
+            a.results[g + i] = static_cast<COLLISION>(codes[i]);
+    }
+    classifyScalar(a, g, end);
+}
+
+__attribute__((target("avx2")))
+static void classifyAVX2(const BatchKernelArgs &a, std::uint32_t begin, std::uint32_t end)
+{
+    const __m256i zero = _mm256_setzero_si256(), one = _mm256_set1_epi32(1);
+    const __m256i maxX = _mm256_set1_epi32(a.xTiles - 1), maxY = _mm256_set1_epi32(a.yTiles - 1);
+    const __m256i width = _mm256_set1_epi32(a.xTiles), bitMask = _mm256_set1_epi32(31);
+    const __m256i laneWords = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(a.words));
+    const int *body = reinterpret_cast<const int *>(a.body), *food = reinterpret_cast<const int *>(a.food);
+    alignas(32) std::int32_t codes[8];
+
+    std::uint32_t g = begin;
+    for (; g + 8 <= end; g += 8)
+    {
+        long long raw;
+        std::memcpy(&raw, a.dirs + g, 8);
+        __m256i dir = _mm256_cvtepi8_epi32(_mm_cvtsi64_si128(raw));
+
+        // Direction application, the compares return -1 for true
+        __m256i dx = _mm256_sub_epi32(_mm256_cmpeq_epi32(dir, _mm256_set1_epi32(2)), _mm256_cmpeq_epi32(dir, _mm256_set1_epi32(3)));
+        __m256i dy = _mm256_sub_epi32(_mm256_cmpeq_epi32(dir, _mm256_set1_epi32(0)), _mm256_cmpeq_epi32(dir, _mm256_set1_epi32(1)));
+        __m256i x = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a.headX + g)), dx);
+        __m256i y = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a.headY + g)), dy);
+
+        // Wall tests, out of bounds lanes look up tile 0 which is always valid
+        __m256i wall = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(zero, x), _mm256_cmpgt_epi32(x, maxX)),
+                                       _mm256_or_si256(_mm256_cmpgt_epi32(zero, y), _mm256_cmpgt_epi32(y, maxY)));
+        __m256i tile = _mm256_andnot_si256(wall, _mm256_add_epi32(_mm256_mullo_epi32(y, width), x));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(a.target + g), tile);
+
+        // Occupancy lookups, one gather per bitboard
+        __m256i word = _mm256_add_epi32(_mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(g * a.words)), laneWords),
+                                        _mm256_srli_epi32(tile, 5));
+        __m256i bit = _mm256_and_si256(tile, bitMask);
+        __m256i bodyHit = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srlv_epi32(_mm256_i32gather_epi32(body, word, 4), bit), one), one);
+        __m256i foodHit = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srlv_epi32(_mm256_i32gather_epi32(food, word, 4), bit), one), one);
+        __m256i neck = _mm256_cmpeq_epi32(tile, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a.neck + g)));
+        __m256i noDir = _mm256_or_si256(_mm256_cmpgt_epi32(dir, _mm256_set1_epi32(3)), _mm256_cmpgt_epi32(zero, dir));
+        __m256i dead = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a.alive + g)), zero);
+
+        // Resolve in the same priority as the scalar kernel, last blend wins
+        __m256i code = _mm256_and_si256(foodHit, _mm256_set1_epi32(static_cast<int>(COLLISION::FOOD)));
+        code = _mm256_blendv_epi8(code, _mm256_set1_epi32(static_cast<int>(COLLISION::SNAKE)), bodyHit);
+        code = _mm256_blendv_epi8(code, _mm256_set1_epi32(static_cast<int>(COLLISION::NECK)), neck);
+        code = _mm256_blendv_epi8(code, _mm256_set1_epi32(static_cast<int>(COLLISION::WALL)), wall);
+        code = _mm256_andnot_si256(noDir, code);
+        code = _mm256_blendv_epi8(code, _mm256_set1_epi32(static_cast<int>(COLLISION::SNAKE)), dead);
+
+        _mm256_store_si256(reinterpret_cast<__m256i *>(codes), code);
+        for (int i = 0; i < 8; ++i)
+            a.results[g + i] = static_cast<COLLISION>(codes[i]);
+    }
+    classifyScalar(a, g, end);
+}
+
+#endif
+
+struct BatchKernelEntry
+{
+    BatchKernel kernel;
+    std::string name;
+};
+
+// Best kernel the CPU supports, picked on first use
+static const BatchKernelEntry &batchKernel()
+{
+    static const BatchKernelEntry entry = []()
+    {
+#ifdef BATCH_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return BatchKernelEntry{classifyAVX2, "avx2"};
+        if (__builtin_cpu_supports("sse4.1"))
+            return BatchKernelEntry{classifySSE41, "sse4.1"};
+#endif
+        return BatchKernelEntry{classifyScalar, "scalar"};
+    }();
+    return entry;
+}
+
+BatchSimulation::BatchSimulation(std::uint32_t games, std::uint16_t xTiles, std::uint16_t yTiles)
+{
+    if (xTiles == 0 || yTiles == 0 || (static_cast<std::uint32_t>(xTiles) * yTiles) > 0xFFFF)
+        throw std::invalid_argument("BatchSimulation::BatchSimulation | The board must have between 1 and 65535 tiles");
+
+    pXTiles = xTiles;
+    pYTiles = yTiles;
+    pTiles = pXTiles * pYTiles;
+    pWords = (pTiles + 31) / 32;
+    // Bitboard words are addressed with 32 bit indices by the gathers
+    if (games == 0 || (static_cast<std::uint64_t>(games) * pWords) > 0x7FFFFFFF)
+        throw std::invalid_argument("BatchSimulation::BatchSimulation | Invalid amount of games");
+    pGames = games;
+
+    pHeadX.resize(games);
+    pHeadY.resize(games);
+    pNeck.resize(games);
+    pAlive.resize(games);
+    pTarget.resize(games);
+    pSnakeHead.resize(games);
+    pSnakeLength.resize(games);
+    pFreeTileCount.resize(games);
+    pSeed.resize(games);
+    pMt.resize(games);
+
+    pSnake.resize(static_cast<std::size_t>(games) * pTiles);
+    pFreeTiles.resize(static_cast<std::size_t>(games) * pTiles);
+    pFreeTileSlot.resize(static_cast<std::size_t>(games) * pTiles);
+    pBody.resize(static_cast<std::size_t>(games) * pWords);
+    pFood.resize(static_cast<std::size_t>(games) * pWords);
+
+    this->resetAll(0);
+}
+
+void BatchSimulation::reset(std::uint32_t game, std::uint32_t seed)
+{
+    // Same sequence of draws as Simulation::reset(), the color seed isn't needed here
+    pSeed[game] = seed;
+    pMt[game].seed(seed);
+    pMt[game]();
+
+    std::uint16_t *snake = &pSnake[static_cast<std::size_t>(game) * pTiles];
+    std::uint16_t *freeTiles = &pFreeTiles[static_cast<std::size_t>(game) * pTiles];
+    std::uint16_t *freeTileSlot = &pFreeTileSlot[static_cast<std::size_t>(game) * pTiles];
+    std::fill(snake, snake + pTiles, 0);
+    for (std::int32_t i = 0; i < pTiles; ++i)
+    {
+        freeTiles[i] = i;
+        freeTileSlot[i] = i;
+    }
+    pFreeTileCount[game] = pTiles;
+    std::fill(&pBody[static_cast<std::size_t>(game) * pWords], &pBody[static_cast<std::size_t>(game) * pWords] + pWords, 0);
+    std::fill(&pFood[static_cast<std::size_t>(game) * pWords], &pFood[static_cast<std::size_t>(game) * pWords] + pWords, 0);
+
+    // The snake starts at the top left tile
+    pSnakeHead[game] = 0;
+    pSnakeLength[game] = 1;
+    pHeadX[game] = 0;
+    pHeadY[game] = 0;
+    pNeck[game] = -1;
+    pAlive[game] = 1;
+    pBody[static_cast<std::size_t>(game) * pWords] |= 1;
+    takeTile(game, 0);
+
+    respawnFood(game, Simulation::STARTING_FOOD);
+}
+
+void BatchSimulation::resetAll(std::uint32_t firstSeed)
+{
+    for (std::uint32_t g = 0; g < pGames; ++g)
+        this->reset(g, firstSeed + g);
+}
+
+void BatchSimulation::step(const DIRECTION *dirs, COLLISION *results)
+{
+    BatchKernelArgs args;
+    args.dirs = dirs;
+    args.results = results;
+    args.headX = pHeadX.data();
+    args.headY = pHeadY.data();
+    args.neck = pNeck.data();
+    args.alive = pAlive.data();
+    args.target = pTarget.data();
+    args.body = pBody.data();
+    args.food = pFood.data();
+    args.xTiles = pXTiles;
+    args.yTiles = pYTiles;
+    args.words = pWords;
+    batchKernel().kernel(args, 0, pGames);
+
+    // Commit the moves, only the games that actually move do any work here
+    for (std::uint32_t g = 0; g < pGames; ++g)
+    {
+        switch (results[g])
+        {
+        case COLLISION::FOOD:
+        {
+            moveSnake(g, pTarget[g], true);
+            respawnFood(g, 1);
+            break;
+        }
+        case COLLISION::NO_COLLISION:
+        {
+            if (static_cast<std::int8_t>(dirs[g]) >= 0 && dirs[g] < DIRECTION::NO_DIRECTION)
+                moveSnake(g, pTarget[g], false);
+            break;
+        }
+        case COLLISION::SNAKE:
+        {
+            pAlive[g] = 0;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+void BatchSimulation::moveSnake(std::uint32_t game, std::uint16_t tile, bool ate)
+{
+    std::uint16_t *snake = &pSnake[static_cast<std::size_t>(game) * pTiles];
+    std::uint32_t *body = &pBody[static_cast<std::size_t>(game) * pWords];
+    std::uint16_t head = pSnakeHead[game], length = pSnakeLength[game];
+
+    // Push the new head, the ring grows towards lower indices
+    head = (head == 0) ? (pTiles - 1) : (head - 1);
+    snake[head] = tile;
+
+    // Pop the tail, unless the snake is growing. Food is eaten in place
+    if (ate)
+    {
+        pFood[(static_cast<std::size_t>(game) * pWords) + (tile >> 5)] &= ~(1u << (tile & 31));
+        length++;
+    }
+    else
+    {
+        std::uint16_t tail = snake[(head + length) % pTiles];
+        body[tail >> 5] &= ~(1u << (tail & 31));
+        freeTile(game, tail);
+    }
+
+    body[tile >> 5] |= (1u << (tile & 31));
+    if (!ate)
+        takeTile(game, tile);
+
+    pSnakeHead[game] = head;
+    pSnakeLength[game] = length;
+    pNeck[game] = (length > 1) ? snake[(head + 1) % pTiles] : -1;
+    pHeadX[game] = tile % pXTiles;
+    pHeadY[game] = tile / pXTiles;
+}
+
+// Same swap and pop bookkeeping as Simulation::setTile(), in the same order
+void BatchSimulation::freeTile(std::uint32_t game, std::uint16_t tile)
+{
+    std::uint16_t *freeTiles = &pFreeTiles[static_cast<std::size_t>(game) * pTiles];
+    std::uint16_t *freeTileSlot = &pFreeTileSlot[static_cast<std::size_t>(game) * pTiles];
+    freeTiles[pFreeTileCount[game]] = tile;
+    freeTileSlot[tile] = pFreeTileCount[game]++;
+}
+
+void BatchSimulation::takeTile(std::uint32_t game, std::uint16_t tile)
+{
+    std::uint16_t *freeTiles = &pFreeTiles[static_cast<std::size_t>(game) * pTiles];
+    std::uint16_t *freeTileSlot = &pFreeTileSlot[static_cast<std::size_t>(game) * pTiles];
+    std::uint16_t last = freeTiles[--pFreeTileCount[game]];
+    freeTiles[freeTileSlot[tile]] = last;
+    freeTileSlot[last] = freeTileSlot[tile];
+}
+
+void BatchSimulation::respawnFood(std::uint32_t game, std::uint8_t amount)
+{
+    std::uint16_t *freeTiles = &pFreeTiles[static_cast<std::size_t>(game) * pTiles];
+    for (std::uint8_t i = 0; i < amount; ++i)
+    {
+        if (pFreeTileCount[game] == 0)
+            return;
+
+        std::uint16_t tile = freeTiles[randomBelow(pMt[game], pFreeTileCount[game])];
+        randomBelow(pMt[game], Simulation::FOOD_KINDS); // The sprite kind, drawn to stay in step with Simulation
+        pFood[(static_cast<std::size_t>(game) * pWords) + (tile >> 5)] |= (1u << (tile & 31));
+        takeTile(game, tile);
+    }
+}
+
+std::uint32_t BatchSimulation::getGames() const
+{
+    return pGames;
+}
+
+std::uint16_t BatchSimulation::getScore(std::uint32_t game) const
+{
+    return static_cast<std::uint16_t>(pSnakeLength[game] - 1);
+}
+
+std::uint32_t BatchSimulation::getSeed(std::uint32_t game) const
+{
+    return pSeed[game];
+}
+
+bool BatchSimulation::isAlive(std::uint32_t game) const
+{
+    return pAlive[game] != 0;
+}
+
+std::uint16_t BatchSimulation::getLength(std::uint32_t game) const
+{
+    return pSnakeLength[game];
+}
+
+std::uint16_t BatchSimulation::getSegment(std::uint32_t game, std::uint16_t segment) const
+{
+    return pSnake[(static_cast<std::size_t>(game) * pTiles) + ((pSnakeHead[game] + segment) % pTiles)];
+}
+
+vec2d BatchSimulation::getHeadTile(std::uint32_t game) const
+{
+    vec2d tile;
+    tile.x = pHeadX[game];
+    tile.y = pHeadY[game];
+    return tile;
+}
+
+bool BatchSimulation::hasFood(std::uint32_t game, std::uint16_t tile) const
+{
+    return testBit(pFood.data(), pWords, game, tile);
+}
+
+std::uint16_t BatchSimulation::getXTiles() const
+{
+    return static_cast<std::uint16_t>(pXTiles);
+}
+
+std::uint16_t BatchSimulation::getYTiles() const
+{
+    return static_cast<std::uint16_t>(pYTiles);
+}
+
+const std::uint32_t *BatchSimulation::getFoodBoard(std::uint32_t game) const
+{
+    return &pFood[static_cast<std::size_t>(game) * pWords];
+}
+
+void BatchSimulation::writeObservation(std::uint32_t game, std::uint8_t *out) const
+{
+    std::memset(out, static_cast<int>(CELL::EMPTY), pTiles);
+
+    // Only a handful of food bits are set, skip straight to them
+    const std::uint32_t *food = &pFood[static_cast<std::size_t>(game) * pWords];
+    for (std::int32_t word = 0; word < pWords; ++word)
+        for (std::uint32_t bits = food[word]; bits != 0; bits &= bits - 1)
+            out[(word * 32) + __builtin_ctz(bits)] = static_cast<std::uint8_t>(CELL::FOOD);
+
+    std::uint16_t length = pSnakeLength[game];
+    for (std::uint16_t segment = 0; segment < length; ++segment)
+    {
+        CELL cell = (segment == 0) ? CELL::HEAD : ((segment == 1) ? CELL::NECK : CELL::BODY);
+        out[getSegment(game, segment)] = static_cast<std::uint8_t>(cell);
+    }
+}
+
+std::string BatchSimulation::getKernelName()
+{
+    return batchKernel().name;
+}
@@ -0,0 +1,85 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef BATCH_SIMULATION_HPP
+#define BATCH_SIMULATION_HPP
+
+#include <vector>
+#include <random>
+#include <string>
+#include <cstdint>
+#include "simulation.hpp"
+
+// Many games on equally sized boards stored as structure of arrays, all of them
+// advance with a single step() call. Every game plays out exactly like a
+// Simulation given the same seed and moves.
+//
+// A step runs in two passes: a vectorized one that applies the directions and
+// tests walls, the neck and the body / food bitboards for every game at once,
+// then a scalar one that commits the moves (ring buffer, free tiles, food spawns).
+// The vector kernel is picked once at startup: AVX2, SSE4.1 or plain C++.
+class BatchSimulation
+{
+private:
+    std::uint32_t pGames;
+    std::int32_t pXTiles, pYTiles, pTiles;
+    std::int32_t pWords; // 32 bit bitboard words per game
+
+    // Per game state, one entry per game
+    std::vector<std::int32_t> pHeadX, pHeadY;
+    std::vector<std::int32_t> pNeck;   // Tile of the segment after the head, -1 when there's none
+    std::vector<std::int32_t> pAlive;  // 0 or 1
+    std::vector<std::int32_t> pTarget; // Tile the head moves into, written by the vector pass
+    std::vector<std::uint16_t> pSnakeHead, pSnakeLength, pFreeTileCount;
+    std::vector<std::uint32_t> pSeed;
+    std::vector<GameRandom> pMt;
+
+    // Per game blocks, pTiles entries (pWords for the bitboards) per game
+    std::vector<std::uint16_t> pSnake;
+    std::vector<std::uint16_t> pFreeTiles, pFreeTileSlot;
+    std::vector<std::uint32_t> pBody, pFood; // Body includes the head and neck
+
+    void moveSnake(std::uint32_t game, std::uint16_t tile, bool ate);
+    void freeTile(std::uint32_t game, std::uint16_t tile);
+    void takeTile(std::uint32_t game, std::uint16_t tile);
+    void respawnFood(std::uint32_t game, std::uint8_t amount);
+
+public:
+    // Tiles are stored as 16 bit indices, so the board is limited to 65535 tiles (any shape,
+    // unlike Simulation's 4096 per side). Throws std::invalid_argument on a bigger or empty board
+    BatchSimulation(std::uint32_t games, std::uint16_t xTiles, std::uint16_t yTiles);
+
+    void reset(std::uint32_t game, std::uint32_t seed);
+    // Game g is seeded with firstSeed + g
+    void resetAll(std::uint32_t firstSeed);
+    // One move for every game, dirs and results hold one entry per game. Dead
+    // games report COLLISION::SNAKE and stay as they were
+    void step(const DIRECTION *dirs, COLLISION *results);
+
+    std::uint32_t getGames() const;
+    std::uint16_t getXTiles() const;
+    std::uint16_t getYTiles() const;
+    std::uint16_t getScore(std::uint32_t game) const;
+    std::uint32_t getSeed(std::uint32_t game) const;
+    bool isAlive(std::uint32_t game) const;
+    std::uint16_t getLength(std::uint32_t game) const;
+    // Tile index of a body segment, segment 0 is the head
+    std::uint16_t getSegment(std::uint32_t game, std::uint16_t segment) const;
+    vec2d getHeadTile(std::uint32_t game) const;
+    bool hasFood(std::uint32_t game, std::uint16_t tile) const;
+    // Food bitboard, bit t of word t / 32 is set when tile t holds food
+    const std::uint32_t *getFoodBoard(std::uint32_t game) const;
+    // The game's board as one CELL tag per tile, row major, into out (xTiles * yTiles bytes)
+    void writeObservation(std::uint32_t game, std::uint8_t *out) const;
+    // Name of the vector kernel in use
+    static std::string getKernelName();
+};
+
+#endif
@@ -8,54 +8,15 @@
 // License: MIT License
 // Website: https://xenobyte.xyz/projects/?nav=snake-sgl
 
+#include <stdexcept>
 #include "grid.hpp"
 
-void Grid::generateGrid()
-{
-    int horizontalLimit = pWidth / pTileSize, verticalLimit = pHeight / pTileSize;
-    int tileNum = 1;
-    for (int x = 0; x < horizontalLimit; ++x)
-    {
-        for (int y = 0; y < verticalLimit; ++y)
-        {
-            auto newTile = new Tile();
-            newTile->sprite.position.x = (pTileSize * x);
-            newTile->sprite.position.y = (pTileSize * y);
-            newTile->sprite.size.x = pTileSize;
-            newTile->sprite.size.y = pTileSize;
-            newTile->sprite.color = pColor;
-            newTile->id = tileNum;
-            tileNum++;
-            pTiles.push_back(std::move(newTile));
-        }
-    }
-    SGL_Log("total tiles: " + std::to_string(pTiles.size()));
-    std::cout << "H LIMITs: "  << horizontalLimit << "\n";
-    std::cout << "V LIMITs: "  << verticalLimit << "\n";
-}
-
 Grid::~Grid()
 {
-    destroyTiles();
 }
 
-void Grid::destroyTiles()
-{
-    SGL_Log("Destroying game data...");
-    for (std::vector<Tile *>::const_iterator iter = pTiles.begin(); iter != pTiles.end(); ++iter)
-        delete (*iter);
-    for (std::vector<Food *>::const_iterator iter = pFood.begin(); iter != pFood.end(); ++iter)
-        delete (*iter);
-
-    pTiles.clear();
-    pFood.clear();
-    pBody.clear();
-    SGL_Log("Done.");
-}
-
-
-
 Grid::Grid(int x, int y, int w, int h, int size, const SGL_Color &color, SGL_Texture texture)
+    : pScheduler(UPDATES_PER_SECOND, TickScheduler::toFixed(DEFAULT_SPEED), MAX_TICKS_PER_UPDATE), pSim(w, h), pRewind(REWIND_TICKS), pAutopilot(w, h)
 {
     // General data
     pPosX = x;
@@ -66,12 +27,31 @@ Grid::Grid(int x, int y, int w, int h, int size, const SGL_Color &color, SGL_Tex
     pTexture = texture;
     pTransitionSpeed = 0.0;
     pColor = color;
-    pSpeed = 30;
-    pSpeedCounter = 0;
     pTimeCounter = 0.0;
     pGameTime = 0.0;
+    pBotPolicy = POLICY::GREEDY;
+    pAutopilotEnabled = false;
+    pRewinding = false;
     pXTiles = pWidth / pTileSize;
     pYTiles = pHeight / pTileSize;
+    SGL_Log("total tiles: " + std::to_string(static_cast<std::uint32_t>(pXTiles) * pYTiles));
+
+    // Board tiles, positioned at render time
+    pTileSprite.size.x = pTileSize;
+    pTileSprite.size.y = pTileSize;
+    pTileSprite.color = pColor;
+    pTileSprite.texture = pTexture;
+    pTileSprite.resetUVCoords();
+
+    // Player, positions are taken from the simulation at render time
+    pHeadSprite.size.x = pTileSize;
+    pHeadSprite.texture = pTexture;
+    pHeadSprite.size.y = pTileSize;
+    pHeadSprite.color = SGL_Color(1.0f, 1.0f, 1.0f, 1.0f);
+    pHeadSprite.changeUVCoords(128, 0, 16, 16);
+    // Body parts share the head's sprite, tinted per segment
+    pBodySprite = pHeadSprite;
+    pFoodSprite = pHeadSprite;
 
     this->resetGame();
 
@@ -81,45 +61,54 @@ Grid::Grid(int x, int y, int w, int h, int size, const SGL_Color &color, SGL_Tex
 
 void Grid::resetGame()
 {
-    // Destroy the current tiles before proceeding
-    this->destroyTiles();
+    this->resetGame(pRnd());
+}
 
-    int horizontalLimit = pWidth / pTileSize, verticalLimit = pHeight / pTileSize;
-    int tileNum = 1;
-    for (int x = 0; x < horizontalLimit; ++x)
+void Grid::resetGame(std::uint32_t seed)
+{
+    // Everything below reuses the storage of the previous game, a restart doesn't allocate
+    pSim.reset(seed);
+    pReplay.start(pSim);
+    pRewind.clear();
+    if (pArena)
     {
-        for (int y = 0; y < verticalLimit; ++y)
-        {
-            auto newTile = new Tile();
-            newTile->sprite.position.x = (pTileSize * pPosX);
-            newTile->sprite.position.y = (pTileSize * pPosY);
-            newTile->sprite.size.x = pTileSize;
-            newTile->sprite.size.y = pTileSize;
-            newTile->sprite.color = pColor;
-            newTile->sprite.texture = pTexture;
-            newTile->sprite.resetUVCoords();
-            newTile->id = tileNum;
-            tileNum++;
-            pTiles.push_back(std::move(newTile));
-        }
+        pArena->reset(seed);
+        pBotRng.seed(seed);
+        std::fill(pArenaMoves.begin(), pArenaMoves.end(), DIRECTION::NO_DIRECTION);
     }
-    SGL_Log("total tiles: " + std::to_string(pTiles.size()));
-    std::cout << "H LIMITs: "  << horizontalLimit << "\n";
-    std::cout << "V LIMITs: "  << verticalLimit << "\n";
-
-
-    // Player
-    pHead.sprite.position.x = pPosX;
-    pHead.sprite.position.y = pPosY;
-    pHead.sprite.size.x = pTileSize;
-    pHead.sprite.texture = pTexture;
-    pHead.sprite.size.y = pTileSize;
-    pHead.sprite.color = SGL_Color(1.0f, 1.0f, 1.0f, 1.0f);
-    pHead.sprite.changeUVCoords(128, 0, 16, 16);
-    pHead.bodyPiece = 0;
-
-    respawnFood(14);
     pNextMove = DIRECTION::NO_DIRECTION;
+    pScheduler.reset();
+    pAutopilot.reset();
+}
+
+void Grid::setBots(std::uint32_t bots, POLICY policy)
+{
+    if (bots == 0)
+        pArena.reset();
+    else
+    {
+        pArena.reset(new Arena(pXTiles, pYTiles, bots + 1));
+        pArenaMoves.assign(bots + 1, DIRECTION::NO_DIRECTION);
+        pArenaResults.assign(bots + 1, COLLISION::NO_COLLISION);
+    }
+    pBotPolicy = policy;
+    this->resetGame();
+}
+
+bool Grid::hasBots() const
+{
+    return static_cast<bool>(pArena);
+}
+
+void Grid::setAutopilot(bool enabled)
+{
+    pAutopilotEnabled = enabled;
+    pAutopilot.reset();
+}
+
+bool Grid::getAutopilot() const
+{
+    return pAutopilotEnabled;
 }
 
 void Grid::moveSnake(DIRECTION dir)
@@ -127,71 +116,31 @@ void Grid::moveSnake(DIRECTION dir)
     pNextMove = dir;
 }
 
-bool Grid::update()
+void Grid::setRewinding(bool rewinding)
 {
-    pSpeedCounter++;
-    int dx = pHead.sprite.position.x;
-    int dy = pHead.sprite.position.y;
+    pRewinding = rewinding;
+}
 
-    if (pSpeedCounter >= (60/pSpeed))
-    {
-        // Update the snake
-        switch (pNextMove)
-        {
-        case DIRECTION::UP:
-        {
-            dy -= pTileSize;
-            break;
-        }
-        case DIRECTION::DOWN:
-        {
-            dy += pTileSize;
-            break;
-        }
-        case DIRECTION::LEFT:
-        {
-            dx -= pTileSize;
-            break;
-        }
-        case DIRECTION::RIGHT:
-        {
-            dx += pTileSize;
-            break;
-        }
-        default:
-            break;
-        }
-        //pNextMove = DIRECTION::NO_DIRECTION;
+bool Grid::rewind()
+{
+    if (pArena || !pRewind.rewind(pSim))
+        return false;
+    pReplay.unrecord();
+    // Carry on the way the snake was going at that point
+    pNextMove = pRewind.getLastMove();
+    pAutopilot.reset();
+    return true;
+}
 
-        switch (checkForCollision(dx, dy))
-        {
-        case COLLISION::FOOD:
-        {
-            increaseScore();
-            moveSnake(dx, dy);
-            respawnFood(1);
-            break;
-        }
-        case COLLISION::NO_COLLISION:
-        {
-            moveSnake(dx, dy);
-            break;
-        }
-        case COLLISION::WALL:
-        {
-            SGL_Log("WALL COLLISION");
-            break;
-        }
-        case COLLISION::SNAKE:
-        {
-            SGL_Log("BODY COLLISION");
+bool Grid::update()
+{
+    // Every due move is played, however many there are
+    for (std::uint32_t ticks = pScheduler.advance(1); ticks > 0; --ticks)
+    {
+        if (pRewinding && !pArena)
+            rewind();
+        else if (!step())
             return false;
-            break;
-        }
-
-        }
-
-        pSpeedCounter = 0;
     }
 
     pTimeCounter = 0.0;
@@ -199,6 +148,55 @@ bool Grid::update()
     return true;
 }
 
+bool Grid::step()
+{
+    COLLISION result;
+    // The autopilot only plays single player games
+    if (pAutopilotEnabled && !pArena)
+        pNextMove = pAutopilot.nextMove(pSim, pNextMove);
+
+    if (pArena)
+    {
+        // Bots decide on the board as it is, then everyone moves at once
+        pArenaMoves[0] = pNextMove;
+        for (std::uint32_t i = 1; i < pArena->getSnakeCount(); ++i)
+            if (pArena->isAlive(i))
+                pArenaMoves[i] = choosePolicyMove(pBotPolicy, *pArena, i, pArenaMoves[i], pBotRng);
+        pArena->step(pArenaMoves.data(), pArenaResults.data());
+        result = pArenaResults[0];
+    }
+    else
+    {
+        pReplay.record(pSim, pNextMove);
+        result = pRewind.step(pSim, pNextMove);
+    }
+
+    switch (result)
+    {
+    case COLLISION::FOOD:
+    {
+        SGL_Log("score increased: " + std::to_string(getScore()));
+        break;
+    }
+    case COLLISION::WALL:
+    {
+        SGL_Log("WALL COLLISION");
+        // Only fatal with WALL_RULE::DEATH
+        if (!pArena && !pSim.isAlive())
+            return false;
+        break;
+    }
+    case COLLISION::SNAKE:
+    {
+        SGL_Log("BODY COLLISION");
+        return false;
+    }
+    default:
+        break;
+    }
+    return true;
+}
+
 bool Grid::renderTransition(SGL_Renderer &r, SGL_AssetManager &am)
 {
     // Get the initial tile
@@ -228,14 +226,19 @@ bool Grid::renderTransition(SGL_Renderer &r, SGL_AssetManager &am)
 
     // }
 
-    pTiles[pTransitionTileAnimation]->sprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
-    r.renderSprite(pTiles[pTransitionTileAnimation]->sprite);
-
-    pTiles[(pTiles.size() - 1) - pTransitionTileAnimation]->sprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
-    r.renderSprite(pTiles[(pTiles.size() -1) - pTransitionTileAnimation]->sprite);
+    // One tile from each end of the board per frame
+    std::uint32_t tiles = static_cast<std::uint32_t>(pXTiles) * pYTiles;
+    std::uint32_t animated[2] = {pTransitionTileAnimation, (tiles - 1) - pTransitionTileAnimation};
+    pTileSprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
+    for (std::uint32_t tile : animated)
+    {
+        pTileSprite.position.x = pPosX + ((tile % pXTiles) * pTileSize);
+        pTileSprite.position.y = pPosY + ((tile / pXTiles) * pTileSize);
+        r.renderSprite(pTileSprite);
+    }
 
     pTransitionTileAnimation++;
-    if (pTransitionTileAnimation >= pTiles.size())
+    if (pTransitionTileAnimation >= tiles)
     {
         pTransitionTileAnimation = 0;
         return true;
@@ -255,320 +258,209 @@ bool Grid::renderTransition(SGL_Renderer &r, SGL_AssetManager &am)
     // Is the animation finished?
 }
 
-uint16_t Grid::getScore()
+std::uint32_t Grid::getSeed()
 {
-    return (static_cast<uint16_t>(this->pBody.size()));
+    return pArena ? pArena->getSeed() : pSim.getSeed();
 }
 
-bool Grid::update(int mouseX, int mouseY)
+std::uint32_t Grid::getScore()
 {
-    for (std::vector<Tile *>::const_iterator iter = pTiles.begin(); iter != pTiles.end(); ++iter)
-    {
-        (*iter)->selected = false;
-        if ( ( (*iter)->position.x) <= mouseX &&
-             ( ( (*iter)->position.x + (*iter)->position.w) >= mouseX ) &&
-             ( ( (*iter)->position.y) <= mouseY ) &&
-             ( (*iter)->position.y + (*iter)->position.z) >= mouseY )
-        {
-            (*iter)->selected = true;
-            pSelectedTileIndex = (iter - pTiles.begin());
-        }
+    return pArena ? pArena->getScore(0) : pSim.getScore();
+}
 
-    }
+vec2d Grid::getHeadTile()
+{
+    return pArena ? pArena->getHeadTile(0) : pSim.getHeadTile();
+}
 
-    int dx = pHead.sprite.position.x;
-    int dy = pHead.sprite.position.y;
-    // Update the snake
-    switch (pNextMove)
-    {
-    case DIRECTION::UP:
-    {
-        dy -= pTileSize;
-        break;
-    }
-    case DIRECTION::DOWN:
-    {
-        dy += pTileSize;
-        break;
-    }
-    case DIRECTION::LEFT:
-    {
-        dx -= pTileSize;
-        break;
-    }
-    case DIRECTION::RIGHT:
-    {
-        dx += pTileSize;
-        break;
-    }
-    default:
-        break;
-    }
-    //pNextMove = DIRECTION::NO_DIRECTION;
+const Simulation &Grid::getSimulation() const
+{
+    return pSim;
+}
 
-    switch (checkForCollision(dx, dy))
-    {
-    case COLLISION::NO_COLLISION:
-    {
-        SGL_Log("NO COLLISION");
-        pHead.sprite.position.x = dx;
-        pHead.sprite.position.y = dy;
-        break;
-    }
-    case COLLISION::WALL:
-    {
-        SGL_Log("WALL COLLISION");
-        break;
-    }
-    case COLLISION::SNAKE:
-    {
-        SGL_Log("BODY COLLISION");
+bool Grid::saveReplay(const std::string &path)
+{
+    if (pArena)
         return false;
-        break;
-    }
-    case COLLISION::FOOD:
-    {
-        increaseScore();
-        respawnFood(1);
-        break;
-    }
-    }
-
-    return true;
+    pReplay.finish(pSim);
+    return pReplay.save(path);
 }
 
-void Grid::moveSnake(int dx, int dy)
+bool Grid::saveSnapshot(const std::string &path)
 {
-    int previousPosX = pHead.sprite.position.x;
-    int previousPosY = pHead.sprite.position.y;
-    int tmpX, tmpY;
-    // Update the snake's head
-    pHead.sprite.position.x = dx;
-    pHead.sprite.position.y = dy;
-
-    for (auto iter = pBody.begin(); iter != pBody.end() ; ++iter)
-    {
-        tmpX = (*iter).sprite.position.x;
-        tmpY = (*iter).sprite.position.y;
-
-        (*iter).sprite.position.x = previousPosX;
-        (*iter).sprite.position.y = previousPosY;
-
-        previousPosX = tmpX;
-        previousPosY = tmpY;
-    }
+    if (pArena)
+        return false;
+    return ::saveSnapshot(pSim, path);
 }
 
-void Grid::increaseScore()
+bool Grid::loadSnapshot(const std::string &path)
 {
-    Snake newBodyPart;
-    if (pBody.size() == 0)
-        newBodyPart = pHead;
-    else
-        newBodyPart = pBody.back();
-
-    newBodyPart.bodyPiece++;
-    newBodyPart.x -= pTileSize;
-    newBodyPart.sprite.color = {static_cast<float>(rand() / (RAND_MAX + 1.0)), static_cast<float>(rand() / (RAND_MAX + 1.0)), static_cast<float>(rand() / (RAND_MAX + 1.0)), 1.0f};
-    pBody.push_back(newBodyPart);
-    SGL_Log("score increased: " + std::to_string(pBody.size()));
-    SGL_Log("color R: " + std::to_string(newBodyPart.sprite.color.r));
+    if (pArena || !::loadSnapshot(pSim, path))
+        return false;
+
+    // The replay starts over from here, its first keyframe holds the restored state
+    pReplay.start(pSim);
+    pRewind.clear();
+    pNextMove = DIRECTION::NO_DIRECTION;
+    pScheduler.reset();
+    pAutopilot.reset();
+    return true;
 }
 
-COLLISION Grid::checkForCollision(int dx, int dy)
+bool Grid::update(float mouseX, float mouseY)
 {
-    // Check if the upcoming position collides with any solid object
-    // Against walls
-    if (dx < pPosX)
-        SGL_Log("COLLISION LEFT");
-    if ((dx + pTileSize) > (pWidth + pPosX))
-        SGL_Log("COLLISION RIGHT");
-    if (dy < pPosY)
-        SGL_Log("COLLISION DOWN");
-    if (((dy + pTileSize) > (pHeight + pPosY)))
-        SGL_Log("COLLISION UP");
-
-
-    if (dx < pPosX || (dx + pTileSize) > (pWidth + pPosX) ||
-        dy < pPosY || (dy + pTileSize) > (pHeight + pPosY))
-        return COLLISION::WALL;
-
-    // Against a body part
-    std::list<Snake>::iterator iter;
-    for (iter = pBody.begin(); iter != pBody.end();)
-    {
-        if (dx == iter->sprite.position.x &&
-            dy == iter->sprite.position.y)
-        {
-            if ((*iter).bodyPiece == 1) // Neck collision, continue forward
-                return COLLISION::NECK;
+    // Tiles are laid out on a regular grid, the one under the mouse is a division away
+    int x = static_cast<int>(std::floor((mouseX - pPosX) / pTileSize));
+    int y = static_cast<int>(std::floor((mouseY - pPosY) / pTileSize));
+    if (x >= 0 && x < pXTiles && y >= 0 && y < pYTiles)
+        pSelectedTileIndex = (static_cast<std::uint32_t>(y) * pXTiles) + x;
 
-            SGL_Log("Collided with snake body part #" + std::to_string((*iter).bodyPiece));
-            return COLLISION::SNAKE;
-        }
-        else
-            ++iter;
-    }
+    return update();
+}
 
+glm::vec2 Grid::getFollowPosition(float viewW, float viewH)
+{
+    vec2d head = getHeadTile();
+    glm::vec2 target(pPosX + ((head.x + 0.5f) * pTileSize), pPosY + ((head.y + 0.5f) * pTileSize));
 
-    // Food
-    for (auto iter = pFood.begin(); iter != pFood.end();)
-    {
-        if (dx == (*iter)->sprite.position.x &&
-            dy == (*iter)->sprite.position.y)
-        {
-            delete (*iter);
-            iter = pFood.erase(iter);
-            return COLLISION::FOOD;
-        }
-        else
-            ++iter;
-    }
+    // Clamp per axis so the camera stops at the board's edges
+    if (pWidth <= viewW)
+        target.x = pPosX + (pWidth / 2.0f);
+    else
+        target.x = std::min(std::max(target.x, pPosX + (viewW / 2.0f)), pPosX + pWidth - (viewW / 2.0f));
+    if (pHeight <= viewH)
+        target.y = pPosY + (pHeight / 2.0f);
+    else
+        target.y = std::min(std::max(target.y, pPosY + (viewH / 2.0f)), pPosY + pHeight - (viewH / 2.0f));
+    return target;
+}
 
-    return COLLISION::NO_COLLISION;
+// Body part colors are derived from the segment number (the snake's number with bots), no need to store them
+SGL_Color Grid::bodyColor(std::uint32_t segment) const
+{
+    std::uint32_t hash = (segment ^ pSim.getColorSeed()) * 2654435761u;
+    hash ^= hash >> 15;
+    hash *= 2246822519u;
+    hash ^= hash >> 13;
+    return SGL_Color((hash & 0xFF) / 256.0f, ((hash >> 8) & 0xFF) / 256.0f, ((hash >> 16) & 0xFF) / 256.0f, 1.0f);
 }
 
 void Grid::respawnFood(uint8_t amount)
 {
     SGL_Log("Respawning food");
-
-    std::mt19937 mt(pRnd());
-    std::uniform_int_distribution<int> distX(0, pXTiles);
-    std::uniform_int_distribution<int> distY(0, pYTiles);
-    // uint16_t respawnX = distX(mt);
-    // uint16_t respawnY = distY(mt);
-
-    // SGL_Log("X RAND: " + std::to_string(respawnX));
-    // SGL_Log("Y RAND: " + std::to_string(respawnY));
-
-
-    // std::vector<vec2d> occupiedTiles;
-    // // Get a list of occupied tiles
-    // for (auto iter = pBody.begin(); iter != pBody.end(); iter++)
-    // {
-    //     vec2d tilePos;
-    //     tilePos.x = ((*iter).sprite.position.x / pTileSize);
-    //     tilePos.y = ((*iter).sprite.position.y / pTileSize);
-    //     occupiedTiles.push_back(tilePos);
-    //     SGL_Log("tilePosX: " + std::to_string(tilePos.x));
-    //     SGL_Log("tilePosY: " + std::to_string(tilePos.y));
-    // }
-    // SGL_Log("total occupied tiles: " + std::to_string(occupiedTiles.size()));
-
-    // for (int i=0; i<16; ++i)
-    //     std::cout << "RANDOM: " << pDist(mt) << "\n";
-
-
-    for (int i = 0; i < amount; ++i)
-    {
-        // Randomize a new position
-        uint16_t respawnX = distX(mt);
-        uint16_t respawnY = distY(mt);
-
-        SGL_Log("X: " + std::to_string(respawnX) + " Y: " + std::to_string(respawnY));
-
-        if (respawnX >= pXTiles)
-        {
-            SGL_Log("Food spawned on horizontal limit, fixing");
-            respawnX = pXTiles - 1;
-        }
-        if (respawnY >= pYTiles)
-        {
-            SGL_Log("Food spawned on vertical limit, fixing");
-            respawnY = pYTiles - 1;
-        }
-
-        if (checkForCollision(respawnX, respawnY) != COLLISION::NO_COLLISION)
-        {
-            SGL_Log("Food respawn failed, occupied tile. X: " + std::to_string(respawnX) + " Y: " + std::to_string(respawnY));
-            return;
-        }
-
-        Food *testFood = new Food();
-        testFood->sprite.position.x = (respawnX * pTileSize);
-        testFood->sprite.position.y = (respawnY * pTileSize);
-        testFood->sprite.size.x = pTileSize;
-        testFood->sprite.size.y = pTileSize;
-        testFood->sprite.color = SGL_Color(1.0f, 1.0f, 1.0f, 1.0f);
-        testFood->sprite.texture = pTexture;
-
-        switch(static_cast<uint8_t>(rand() % 6))
-        {
-        case 0:
-        {
-            // apple
-            testFood->sprite.changeUVCoords(144, 32, 16, 16);
-            break;
-        }
-        case 1:
-        {
-            // apple
-            testFood->sprite.changeUVCoords(144, 0, 16, 16);
-            break;
-        }
-
-        case 2:
-        {
-            // cucumber
-            testFood->sprite.changeUVCoords(160, 0, 16, 16);
-            break;
-        }
-        case 3:
-        {
-            // cyanberries
-            testFood->sprite.changeUVCoords(176, 0, 16, 16);
-            break;
-        }
-        case 4:
-        {
-            // leafberry
-            testFood->sprite.changeUVCoords(192, 0, 16, 16);
-            break;
-        }
-        case 5:
-        {
-            // black egg
-            testFood->sprite.changeUVCoords(144, 16, 16, 16);
-            break;
-        }
-        case 6:
-        {
-            // growing potato
-            testFood->sprite.changeUVCoords(160, 16, 16, 16);
-            break;
-        }
-        }
-
-        this->pFood.push_back(std::move(testFood));
-    }
-
+    if (pSim.respawnFood(amount) < amount)
+        SGL_Log("Food respawn failed, no free tiles left");
 }
 
-
 void Grid::render(SGL_Renderer &r, SGL_AssetManager &am)
-
 {
+    this->render(r, am, glm::vec4(pPosX, pPosY, pWidth, pHeight));
+}
 
-    pHead.sprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
-    for (auto iter = pFood.begin(); iter != pFood.end(); iter++)
+void Grid::render(SGL_Renderer &r, SGL_AssetManager &am, const glm::vec4 &viewport)
+{
+    // Sprite sheet region of every food kind
+    static const int foodUV[Simulation::FOOD_KINDS][2] = {
+        {144, 32}, // apple
+        {144, 0},  // apple
+        {160, 0},  // cucumber
+        {176, 0},  // cyanberries
+        {192, 0},  // leafberry
+        {144, 16}  // black egg
+    };
+
+    // Tiles in view, clamped to the board
+    int left = std::max(0, static_cast<int>(std::floor((viewport.x - pPosX) / pTileSize)));
+    int top = std::max(0, static_cast<int>(std::floor((viewport.y - pPosY) / pTileSize)));
+    int right = std::min(pXTiles - 1, static_cast<int>(std::floor((viewport.x + viewport.z - pPosX) / pTileSize)));
+    int bottom = std::min(pYTiles - 1, static_cast<int>(std::floor((viewport.y + viewport.w - pPosY) / pTileSize)));
+    if (left > right || top > bottom)
+        return;
+
+    pHeadSprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
+    pFoodSprite.shader = pHeadSprite.shader;
+    pBodySprite.shader = pHeadSprite.shader;
+
+    // There's only a handful of food, test each piece
+    for (const FoodItem &food : (pArena ? pArena->getFood() : pSim.getFood()))
     {
-        (*iter)->sprite.shader = am.getShader(SGL::DEFAULT_SPRITE_SHADER);
-        r.renderSprite((*iter)->sprite);
+        int x = food.tile % pXTiles, y = food.tile / pXTiles;
+        if (x < left || x > right || y < top || y > bottom)
+            continue;
+        pFoodSprite.position.x = pPosX + (x * pTileSize);
+        pFoodSprite.position.y = pPosY + (y * pTileSize);
+        pFoodSprite.changeUVCoords(foodUV[food.kind][0], foodUV[food.kind][1], 16, 16);
+        r.renderSprite(pFoodSprite);
     }
-    for (auto iter = pBody.begin(); iter != pBody.end() ; ++iter)
+
+    // The snakes can cover the whole board, only the chunks in view are scanned and
+    // the empty ones skipped
+    int shift = Simulation::CHUNK_SHIFT, size = Simulation::CHUNK_SIZE;
+    for (int chunkY = top >> shift; chunkY <= (bottom >> shift); ++chunkY)
     {
-        r.renderSprite((*iter).sprite);
+        for (int chunkX = left >> shift; chunkX <= (right >> shift); ++chunkX)
+        {
+            if ((pArena ? pArena->getChunkCount(chunkX, chunkY) : pSim.getChunkCount(chunkX, chunkY)) == 0)
+                continue;
+
+            int lastY = std::min(bottom, (chunkY * size) + size - 1), lastX = std::min(right, (chunkX * size) + size - 1);
+            for (int y = std::max(top, chunkY * size); y <= lastY; ++y)
+            {
+                for (int x = std::max(left, chunkX * size); x <= lastX; ++x)
+                {
+                    CELL cell = pArena ? pArena->getCell(x, y) : pSim.getCell(x, y);
+                    if (cell == CELL::HEAD && pArena && pArena->getOwner(x, y) != 0)
+                    {
+                        // Bots are drawn in a single color, head included
+                        pBodySprite.position.x = pPosX + (x * pTileSize);
+                        pBodySprite.position.y = pPosY + (y * pTileSize);
+                        pBodySprite.color = bodyColor(pArena->getOwner(x, y));
+                        r.renderSprite(pBodySprite);
+                    }
+                    else if (cell == CELL::HEAD)
+                    {
+                        pHeadSprite.position.x = pPosX + (x * pTileSize);
+                        pHeadSprite.position.y = pPosY + (y * pTileSize);
+                        r.renderSprite(pHeadSprite);
+                    }
+                    else if (cell == CELL::NECK || cell == CELL::BODY)
+                    {
+                        // Body colors follow the segment number, as if drawn head to tail
+                        pBodySprite.position.x = pPosX + (x * pTileSize);
+                        pBodySprite.position.y = pPosY + (y * pTileSize);
+                        if (pArena)
+                            pBodySprite.color = bodyColor(pArena->getOwner(x, y));
+                        else
+                            pBodySprite.color = bodyColor(pSim.getSegmentAt((static_cast<std::uint32_t>(y) * pXTiles) + x));
+                        r.renderSprite(pBodySprite);
+                    }
+                }
+            }
+        }
     }
-    r.renderSprite(pHead.sprite);
-
 }
 
 void Grid::setColor(SGL_Color &color)
 {
     pColor = color;
+    pTileSprite.color = pColor;
+}
+
+void Grid::setSpeed(double movesPerSecond)
+{
+    // Within the range update() never falls behind, every due move is played right away
+    std::uint32_t rate = TickScheduler::toFixed(movesPerSecond);
+    if (rate == 0 || !(movesPerSecond <= MAX_SPEED))
+        throw std::invalid_argument("Grid::setSpeed | The speed must be between 1 / 65536 and 3840 moves per second");
+    pScheduler.setRate(rate);
+}
+
+double Grid::getSpeed() const
+{
+    return TickScheduler::fromFixed(pScheduler.getRate());
 }
 
-uint16_t Grid::selectedTile()
+std::uint32_t Grid::selectedTile()
 {
     return pSelectedTileIndex;
 }
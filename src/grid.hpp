@@ -16,80 +16,76 @@
 #include <memory>
 #include <iostream>
 #include <random>
+#include <cmath>
+#include <algorithm>
 #include <cstdint>
-#include <list>
 #include "skeletonGL/skeletonGL.hpp"
-
-enum class DIRECTION : std::int8_t {UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3, NO_DIRECTION = 4, END_ENUM = 5};
-enum class COLLISION : std::int8_t {NO_COLLISION = 0, WALL = 1, SNAKE = 2, FOOD = 3, NECK = 4, END_ENUM = 5};
-
-
-struct vec2d
-{
-    int x, y;
-};
-
-struct Tile
-{
-    glm::vec4 position;
-    SGL_Color color;
-    bool selected;
-    int id;
-    SGL_Sprite sprite;
-
-    Tile() : position(0.0f), selected(false), id(0) {}
-};
-
-struct Snake
-{
-    int x, y;
-    uint8_t bodyPiece;
-    SGL_Sprite sprite;
-};
-
-struct Food
-{
-    int x, y;
-    SGL_Sprite sprite;
-    bool active;
-};
+#include "simulation.hpp"
+#include "replay.hpp"
+#include "rewind.hpp"
+#include "snapshot.hpp"
+#include "tickScheduler.hpp"
+#include "arena.hpp"
+#include "policy.hpp"
+#include "autopilot.hpp"
 
 class Grid
 {
 private:
     int pWidth, pHeight, pTileSize;
-    uint8_t pXTiles, pYTiles; // Might as well have save these two
+    std::uint16_t pXTiles, pYTiles; // Up to Simulation::MAX_SIDE each
     int pPosX, pPosY;
     SGL_Color pColor;
     SGL_Texture pTexture;
     DIRECTION pNextMove;
-    std::uint8_t pSpeed, pSpeedCounter; // in milliseconds
+    // Moves the snake at its own rate, update() is called at UPDATES_PER_SECOND
+    TickScheduler pScheduler;
     float pTimeCounter, pGameTime; // keep track of when its time to move
-    // Player (snake's head)
-    Snake pHead;
-    std::list<Snake> pBody;
-    std::vector<Tile *> pTiles;
-    std::vector<Food *> pFood;
-    std::vector<Tile *> pTransitionTiles;
-    uint16_t pTransitionTileAnimation = 0;
+    // Game rules, the grid only maps its tiles to pixels. Sprites are built at render time
+    Simulation pSim;
+    ReplayRecorder pReplay; // Every game is recorded, see saveReplay()
+    // The last REWIND_TICKS moves, played backwards instead while pRewinding is set
+    RewindBuffer pRewind;
+    bool pRewinding;
+    // With bots the game is played on an Arena instead, the player is snake 0 and
+    // the rest are driven by pBotPolicy. Replays and snapshots only cover pSim
+    std::unique_ptr<Arena> pArena;
+    std::vector<DIRECTION> pArenaMoves;
+    std::vector<COLLISION> pArenaResults;
+    POLICY pBotPolicy;
+    std::mt19937 pBotRng;
+    // Steers the player instead of the keyboard while enabled
+    Autopilot pAutopilot;
+    bool pAutopilotEnabled;
+    // Tiles aren't stored, a board can hold millions of them. Their rectangles are
+    // computed from the index when needed and drawn with pTileSprite
+    SGL_Sprite pHeadSprite, pBodySprite, pFoodSprite, pTileSprite;
+    std::uint32_t pTransitionTileAnimation = 0;
     float pTransitionSpeed;
-    uint16_t pSelectedTileIndex = 0;
+    std::uint32_t pSelectedTileIndex = 0;
 
-    // Random number generator (used by respawnFood() function)
+    // Seeds every new game, the simulation owns the game's own generator
     std::random_device pRnd;
-    std::mt19937 pMt;
-    // std::uniform_int_distribution<> pDist;
 
 
     // Game status
     bool pAlive = true;
 
-    void generateGrid();
-    COLLISION checkForCollision(int dx, int dy);
-    void increaseScore();
-    void moveSnake(int dx, int dy);
+    // Advances the simulation and logs the outcome, false when the snake died
+    bool step();
+    SGL_Color bodyColor(std::uint32_t segment) const;
 
 public:
+    // Rate at which update() is called, the window's fixed time step
+    static const std::uint32_t UPDATES_PER_SECOND = 60;
+    // Snake moves per second of a new grid
+    static const std::uint32_t DEFAULT_SPEED = 30;
+    // Most moves a single update() plays, which makes the fastest speed 3840 moves per second
+    static const std::uint32_t MAX_TICKS_PER_UPDATE = 64;
+    static const std::uint32_t MAX_SPEED = UPDATES_PER_SECOND * MAX_TICKS_PER_UPDATE;
+    // Five minutes at the default speed, a few hundred kilobytes
+    static const std::uint32_t REWIND_TICKS = DEFAULT_SPEED * 60 * 5;
+
     Grid(int x, int y, int w, int h, int size, const SGL_Color &color, SGL_Texture texture);
     ~Grid();
 
@@ -98,11 +94,33 @@ public:
     void setPlayerTexture(SGL_Texture texture);
 
     bool update();
-    bool update(int mouseX, int mouseY);
+    // Also picks the tile under the mouse, given in world coordinates (see SGL_Window::screenToWorld)
+    bool update(float mouseX, float mouseY);
     void render(SGL_Renderer &r, SGL_AssetManager &am);
+    // Only draws what's inside the viewport (x, y, w, h in world coordinates)
+    void render(SGL_Renderer &r, SGL_AssetManager &am, const glm::vec4 &viewport);
+    // Camera position that keeps the head in view without showing past the board's edges,
+    // boards smaller than the view stay centered
+    glm::vec2 getFollowPosition(float viewW, float viewH);
     void setColor(SGL_Color &color);
+    // Snake moves per second, from 1 / 65536 (TickScheduler's resolution) up to MAX_SPEED.
+    // Several moves can happen in a single update(). Throws std::invalid_argument otherwise
+    void setSpeed(double movesPerSecond);
+    double getSpeed() const;
 
     void resetGame();
+    void resetGame(std::uint32_t seed);
+    // Shares the board with that many scripted snakes from the next game on, 0 goes
+    // back to single player. Throws std::invalid_argument if they don't fit
+    void setBots(std::uint32_t bots, POLICY policy);
+    bool hasBots() const;
+    // Lets the autopilot play, the keyboard's moves are ignored meanwhile
+    void setAutopilot(bool enabled);
+    bool getAutopilot() const;
+    // While set the game plays backwards at the same pace, single player only
+    void setRewinding(bool rewinding);
+    // Takes the last move back, false if there's nothing left to rewind or there are bots
+    bool rewind();
     void respawnFood(uint8_t amount);
 
     // Player
@@ -110,9 +128,16 @@ public:
 
     bool checkTileAvailability();
 
-    uint16_t getScore();
-    void destroyTiles();
-    uint16_t selectedTile();
+    std::uint32_t getScore();
+    std::uint32_t getSeed();
+    vec2d getHeadTile();
+    const Simulation &getSimulation() const;
+    // Writes the current game's replay, returns false if the file can't be written or there are bots
+    bool saveReplay(const std::string &path);
+    // Saves / resumes the game in progress, see snapshot.hpp. Single player only
+    bool saveSnapshot(const std::string &path);
+    bool loadSnapshot(const std::string &path);
+    std::uint32_t selectedTile();
 };
 
 #endif
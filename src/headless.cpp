@@ -0,0 +1,275 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include "headless.hpp"
+
+static void printUsage()
+{
+    std::cerr << "Usage: snake-sgl --headless [--games N] [--ticks M] [--seed S] [--policy random|greedy|cycle|path|mcts[,...]]"
+              << " [--threads T] [--width W] [--height H] [--snakes N] [--search-threads T] [--budget US]"
+              << " [--walls block|death|wrap] [--neck ignore|death] [--growth G]\n";
+}
+
+static std::uint32_t parseNumber(const std::string &value, std::uint32_t max)
+{
+    std::size_t end;
+    unsigned long number = std::stoul(value, &end);
+    if (end != value.size() || number > max)
+        throw std::invalid_argument("invalid number " + value);
+    return static_cast<std::uint32_t>(number);
+}
+
+bool isHeadless(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--headless")
+            return true;
+    return false;
+}
+
+bool parseHeadlessOptions(int argc, char *argv[], RunnerOptions &options)
+{
+    // Every core by default
+    options.threads = std::thread::hardware_concurrency();
+    if (options.threads == 0)
+        options.threads = 1;
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg == "--headless")
+                continue;
+            if (i + 1 >= argc)
+                throw std::invalid_argument("missing value for " + arg);
+
+            std::string value = argv[++i];
+            if (arg == "--games")
+                options.games = parseNumber(value, 0xFFFFFFFF);
+            else if (arg == "--ticks")
+                options.ticks = parseNumber(value, 0xFFFFFFFF);
+            else if (arg == "--seed")
+                options.seed = parseNumber(value, 0xFFFFFFFF);
+            else if (arg == "--width")
+                options.width = parseNumber(value, Simulation::MAX_SIDE);
+            else if (arg == "--height")
+                options.height = parseNumber(value, Simulation::MAX_SIDE);
+            else if (arg == "--threads")
+                options.threads = parseNumber(value, 1024);
+            else if (arg == "--search-threads")
+                options.searchThreads = parseNumber(value, 1024);
+            else if (arg == "--budget")
+                options.searchBudget = parseNumber(value, 0xFFFFFFFF);
+            else if (arg == "--walls")
+            {
+                static const char *names[] = {"block", "death", "wrap"};
+                int rule = 0;
+                while (rule < static_cast<int>(WALL_RULE::END_ENUM) && value != names[rule])
+                    ++rule;
+                if (rule == static_cast<int>(WALL_RULE::END_ENUM))
+                    throw std::invalid_argument("unknown wall rule " + value);
+                options.rules.walls = static_cast<WALL_RULE>(rule);
+            }
+            else if (arg == "--neck")
+            {
+                if (value != "ignore" && value != "death")
+                    throw std::invalid_argument("unknown neck rule " + value);
+                options.rules.neck = (value == "death") ? NECK_RULE::DEATH : NECK_RULE::IGNORE;
+            }
+            else if (arg == "--growth")
+            {
+                options.rules.growth = parseNumber(value, Simulation::MAX_GROWTH);
+                if (options.rules.growth == 0)
+                    throw std::invalid_argument("--growth must be greater than zero");
+            }
+            else if (arg == "--snakes")
+                options.snakes = parseNumber(value, 0xFFFE);
+            else if (arg == "--policy")
+            {
+                // Comma separated, the games are dealt to the policies in turn
+                options.policies.clear();
+                std::stringstream names(value);
+                std::string name;
+                while (std::getline(names, name, ','))
+                {
+                    POLICY policy;
+                    if (!policyFromString(name, policy))
+                        throw std::invalid_argument("unknown policy " + name);
+                    options.policies.push_back(policy);
+                }
+                if (options.policies.empty())
+                    throw std::invalid_argument("no policy given");
+            }
+            else
+                throw std::invalid_argument("unknown option " + arg);
+        }
+
+        if (options.games == 0 || options.ticks == 0 || options.threads == 0 || options.snakes == 0 || options.searchThreads == 0)
+            throw std::invalid_argument("--games, --ticks, --threads, --snakes and --search-threads must be greater than zero");
+        for (POLICY policy : options.policies)
+        {
+            if (policy == POLICY::CYCLE && (options.width % 2 != 0 || options.height < 2))
+                throw std::invalid_argument("the cycle policy needs an even width and at least two rows");
+            if ((policy == POLICY::CYCLE || policy == POLICY::PATH || policy == POLICY::MCTS) && options.snakes > 1)
+                throw std::invalid_argument("the cycle, path and mcts policies can't share the board");
+        }
+        if (options.snakes > 1 && (options.rules.walls != WALL_RULE::BLOCK || options.rules.neck != NECK_RULE::IGNORE || options.rules.growth != 1))
+            throw std::invalid_argument("rule variants only apply to single snake games");
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "snake-sgl: " << e.what() << "\n";
+        printUsage();
+        return false;
+    }
+    return true;
+}
+
+int runHeadless(const RunnerOptions &options)
+{
+    std::unique_ptr<GameRunner> runner;
+    try
+    {
+        runner.reset(new GameRunner(options));
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "snake-sgl: " << e.what() << "\n";
+        return -1;
+    }
+    runner->run();
+
+    std::uint64_t totalTicks = 0;
+    for (std::size_t i = 0; i < options.policies.size(); ++i)
+        totalTicks += runner->getTotals(i).ticks;
+    double seconds = runner->getSeconds();
+
+    std::cout << "Headless run: " << options.games << " games, " << options.width << " x " << options.height
+              << " tiles, seed " << options.seed << ", " << options.threads << " threads";
+    if (options.snakes > 1)
+        std::cout << ", " << options.snakes << " snakes per board";
+    std::cout << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (std::size_t i = 0; i < options.policies.size(); ++i)
+    {
+        const PolicyTotals &totals = runner->getTotals(i);
+        double games = static_cast<double>(totals.games);
+        std::cout << "Policy " << std::left << std::setw(8) << policyToString(options.policies[i]) << std::right
+                  << totals.games << " games, average score " << (totals.score / games)
+                  << ", best " << totals.bestScore << ", " << (totals.ticks / games) << " ticks per game, "
+                  << totals.bodyDeaths << " body deaths, " << totals.wallDeaths << " wall deaths, "
+                  << totals.neckDeaths << " neck deaths, " << totals.timeouts << " timeouts\n";
+    }
+    if (options.snakes > 1)
+        std::cout << "Snake moves / s: " << (totalTicks / seconds) << "\n";
+    else
+        std::cout << "Ticks / second:  " << (totalTicks / seconds) << "\n";
+    std::cout << "Games / second:  " << (options.games / seconds) << "\n";
+    if (runner->getRollouts() > 0)
+    {
+        // Per search thread too, the figure to size a bot farm with
+        double searchSeconds = runner->getSearchSeconds() * options.searchThreads;
+        std::cout << "Rollouts / sec:  " << (runner->getRollouts() / seconds) << ", "
+                  << (runner->getRollouts() / searchSeconds) << " per search thread\n";
+    }
+    std::cout << "Tick latency ns: p50 " << runner->getLatencyPercentile(0.5)
+              << ", p90 " << runner->getLatencyPercentile(0.9)
+              << ", p99 " << runner->getLatencyPercentile(0.99)
+              << ", p99.9 " << runner->getLatencyPercentile(0.999) << "\n";
+
+    return 0;
+}
+
+bool isReplay(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--replay")
+            return true;
+    return false;
+}
+
+int runReplay(int argc, char *argv[])
+{
+    std::string path;
+    std::uint32_t seekTick = 0;
+    bool seek = false;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+                throw std::invalid_argument("missing value for " + arg);
+            if (arg == "--replay")
+                path = argv[++i];
+            else if (arg == "--seek")
+            {
+                seekTick = parseNumber(argv[++i], 0xFFFFFFFF);
+                seek = true;
+            }
+            else
+                throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "snake-sgl: " << e.what() << "\n";
+        std::cerr << "Usage: snake-sgl --replay <file> [--seek <tick>]\n";
+        return -1;
+    }
+
+    ReplayPlayer player;
+    if (!player.load(path))
+    {
+        std::cerr << "snake-sgl: can't read the replay " << path << "\n";
+        return -1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    if (seek)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (!player.seek(seekTick))
+        {
+            std::cerr << "snake-sgl: can't seek to tick " << seekTick << ", the replay has " << player.getTicks() << "\n";
+            return -1;
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        vec2d head = player.getSimulation().getHeadTile();
+        std::cout << "Tick " << seekTick << " reached in " << us << " us: score " << player.getSimulation().getScore()
+                  << ", head at " << head.x << ", " << head.y << "\n";
+    }
+
+    std::uint32_t from = player.getTick();
+    auto start = std::chrono::steady_clock::now();
+    while (player.step())
+        ;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The windowed game moves once every two 60 Hz updates
+    const double realTimeTicks = 30.0;
+    std::uint32_t played = player.getTick() - from;
+    std::cout << "Played " << played << " ticks in " << (seconds * 1e6) << " us, "
+              << ((seconds > 0.0) ? (played / seconds) / realTimeTicks : 0.0) << "x real time\n";
+    std::cout << "Final score " << player.getSimulation().getScore() << ", recorded " << player.getRecordedScore()
+              << ", state hash " << std::hex << player.getSimulation().getHash() << std::dec << "\n";
+
+    return (player.getTick() == player.getTicks() && player.getSimulation().getScore() == player.getRecordedScore()) ? 0 : 1;
+}
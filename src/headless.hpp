@@ -0,0 +1,34 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include <cstdint>
+#include "runner.hpp"
+#include "replay.hpp"
+
+// Runs the game rules without a window and reports the simulation's throughput,
+// enabled with --headless on the command line
+
+// Returns true if --headless was passed
+bool isHeadless(int argc, char *argv[]);
+// Returns false and prints the usage on malformed arguments
+bool parseHeadlessOptions(int argc, char *argv[], RunnerOptions &options);
+// Returns the process' exit code
+int runHeadless(const RunnerOptions &options);
+
+// Returns true if --replay was passed
+bool isReplay(int argc, char *argv[]);
+// Plays back --replay <file>, optionally jumping to --seek <tick> first, and
+// checks the result against the recorded one. Returns the process' exit code
+int runReplay(int argc, char *argv[]);
+
+#endif
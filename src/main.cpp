@@ -8,11 +8,69 @@
 // License: MIT License
 // Website: https://xenobyte.xyz/projects/?nav=snake-sgl
 
+#include <string>
+#include <cstdio>
 #include "window.hpp"
+#include "headless.hpp"
+
+// --board WxH, sets the windowed game's board size in tiles. Returns false if it's malformed
+static bool parseBoardSize(int argc, char *argv[], std::uint16_t &width, std::uint16_t &height)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) != "--board")
+            continue;
+        unsigned int w = 0, h = 0;
+        if (i + 1 >= argc || std::sscanf(argv[i + 1], "%ux%u", &w, &h) != 2 ||
+            w == 0 || h == 0 || w > Simulation::MAX_SIDE || h > Simulation::MAX_SIDE)
+        {
+            std::cerr << "--board expects WIDTHxHEIGHT, each between 1 and " << Simulation::MAX_SIDE << " tiles\n";
+            return false;
+        }
+        width = w;
+        height = h;
+    }
+    return true;
+}
+
+// --bots N, scripted snakes sharing the windowed game's board. Returns false if it's malformed
+static bool parseBots(int argc, char *argv[], std::uint32_t &bots)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string(argv[i]) != "--bots")
+            continue;
+        unsigned int count = 0;
+        char extra;
+        if (i + 1 >= argc || std::sscanf(argv[i + 1], "%u%c", &count, &extra) != 1 || count >= Arena::NO_OWNER - 1)
+        {
+            std::cerr << "--bots expects a number of snakes below " << (Arena::NO_OWNER - 1) << "\n";
+            return false;
+        }
+        bots = count;
+    }
+    return true;
+}
 
 int main(int argc, char *argv[])
 {
-    Window *gm = new Window();
+    // Benchmark the game rules, no window or OpenGL context required
+    if (isHeadless(argc, argv))
+    {
+        RunnerOptions options;
+        if (!parseHeadlessOptions(argc, argv, options))
+            return -1;
+        return runHeadless(options);
+    }
+    if (isReplay(argc, argv))
+        return runReplay(argc, argv);
+
+    std::uint16_t boardW = 0, boardH = 0;
+    std::uint32_t bots = 0;
+    if (!parseBoardSize(argc, argv, boardW, boardH) || !parseBots(argc, argv, bots))
+        return -1;
+
+    Window *gm = new Window(boardW, boardH, bots);
     if (gm->createSGLWindow() != 0)
         return -1;
 
@@ -0,0 +1,253 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <cmath>
+#include "mcts.hpp"
+
+static const DIRECTION directions[4] = {DIRECTION::UP, DIRECTION::DOWN, DIRECTION::LEFT, DIRECTION::RIGHT};
+static const int directionX[4] = {0, 0, -1, 1};
+static const int directionY[4] = {-1, 1, 0, 0};
+
+// UCT exploration constant, rewards are in [0, 1]
+static const float EXPLORATION = 1.0f;
+
+MctsPlayer::MctsPlayer(std::uint16_t xTiles, std::uint16_t yTiles, const RuleSet &rules, std::uint32_t threads,
+                       std::uint32_t budgetMicroseconds, std::uint32_t rolloutDepth, std::uint32_t maxNodes)
+{
+    pBudgetMicroseconds = budgetMicroseconds;
+    pRolloutDepth = rolloutDepth;
+    pMaxNodes = (maxNodes < 5) ? 5 : maxNodes; // Room for the root and its children
+    pRootScore = 0;
+    pGeneration = 0;
+    pPending = 0;
+    pQuit = false;
+    pRollouts = 0;
+    pSearchSeconds = 0.0;
+
+    if (threads == 0)
+        threads = 1;
+    for (std::uint32_t i = 0; i < threads; ++i)
+    {
+        // Throws on an invalid board
+        pWorkers.emplace_back(new Worker(xTiles, yTiles, rules));
+        pWorkers.back()->nodes.reserve(pMaxNodes);
+        pWorkers.back()->path.reserve(pMaxNodes);
+        pWorkers.back()->rng.seed(i);
+    }
+    pRoot.reserve(pWorkers[0]->sim.getSnapshotSize());
+
+    for (std::uint32_t i = 1; i < threads; ++i)
+        pThreads.emplace_back(&MctsPlayer::threadLoop, this, i);
+}
+
+MctsPlayer::~MctsPlayer()
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pQuit = true;
+    }
+    pStart.notify_all();
+    for (auto &thread : pThreads)
+        thread.join();
+}
+
+void MctsPlayer::threadLoop(std::uint32_t index)
+{
+    std::uint64_t generation = 0;
+    for (;;)
+    {
+        std::unique_lock<std::mutex> lock(pMutex);
+        pStart.wait(lock, [&] { return pQuit || pGeneration != generation; });
+        if (pQuit)
+            return;
+        generation = pGeneration;
+        lock.unlock();
+
+        search(*pWorkers[index]);
+
+        lock.lock();
+        if (--pPending == 0)
+            pDone.notify_one();
+    }
+}
+
+DIRECTION MctsPlayer::nextMove(const Simulation &sim, DIRECTION lastMove)
+{
+    if (!sim.isAlive())
+        return lastMove;
+
+    pRoot.resize(sim.getSnapshotSize());
+    sim.writeSnapshot(pRoot.data());
+    pRootScore = sim.getScore();
+
+    auto start = std::chrono::steady_clock::now();
+    pDeadline = start + std::chrono::microseconds(pBudgetMicroseconds);
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pPending = static_cast<std::uint32_t>(pThreads.size());
+        pGeneration++;
+    }
+    pStart.notify_all();
+    search(*pWorkers[0]);
+    {
+        std::unique_lock<std::mutex> lock(pMutex);
+        pDone.wait(lock, [&] { return pPending == 0; });
+    }
+    pSearchSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Root parallelization, the trees are only merged at the root. Its children are
+    // always nodes 1 to 4, in directions order
+    std::uint64_t visits[4] = {0, 0, 0, 0};
+    pRollouts = 0;
+    for (const auto &worker : pWorkers)
+    {
+        for (int i = 0; i < 4; ++i)
+            visits[i] += worker->nodes[1 + i].visits;
+        pRollouts += worker->rollouts;
+    }
+
+    DIRECTION move = lastMove;
+    std::uint64_t best = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (visits[i] > best)
+        {
+            best = visits[i];
+            move = directions[i];
+        }
+    }
+    return move;
+}
+
+void MctsPlayer::search(Worker &worker)
+{
+    std::vector<Node> &nodes = worker.nodes;
+    nodes.clear();
+    nodes.push_back(Node{NO_NODE, 0, 0.0f, DIRECTION::NO_DIRECTION});
+    expand(worker, 0);
+
+    // At least one iteration, even if the budget is already gone
+    do
+    {
+        worker.sim.readSnapshot(pRoot.data(), pRoot.size());
+        worker.path.clear();
+        worker.path.push_back(0);
+
+        // Selection, down to a leaf or a dead end
+        std::uint32_t node = 0;
+        while (nodes[node].firstChild != NO_NODE && worker.sim.isAlive())
+        {
+            node = select(worker, node);
+            worker.sim.step(nodes[node].move);
+            worker.path.push_back(node);
+        }
+
+        // Expansion, once a leaf has been visited before and there's room left
+        if (worker.sim.isAlive() && nodes[node].visits > 0 && nodes.size() + 4 <= pMaxNodes)
+        {
+            expand(worker, node);
+            node = nodes[node].firstChild + (worker.rng() & 3);
+            worker.sim.step(nodes[node].move);
+            worker.path.push_back(node);
+        }
+
+        float reward = rollout(worker);
+        for (std::uint32_t visited : worker.path)
+        {
+            nodes[visited].visits++;
+            nodes[visited].value += reward;
+        }
+        worker.rollouts++;
+    } while (std::chrono::steady_clock::now() < pDeadline);
+}
+
+// The node array never grows past pMaxNodes, references into it stay valid
+void MctsPlayer::expand(Worker &worker, std::uint32_t node)
+{
+    std::vector<Node> &nodes = worker.nodes;
+    nodes[node].firstChild = static_cast<std::uint32_t>(nodes.size());
+    for (int i = 0; i < 4; ++i)
+        nodes.push_back(Node{NO_NODE, 0, 0.0f, directions[i]});
+}
+
+std::uint32_t MctsPlayer::select(const Worker &worker, std::uint32_t node) const
+{
+    const std::vector<Node> &nodes = worker.nodes;
+    std::uint32_t first = nodes[node].firstChild, best = first;
+    float logVisits = std::log(static_cast<float>(nodes[node].visits + 1)), bestScore = -1.0f;
+    for (std::uint32_t child = first; child < first + 4; ++child)
+    {
+        if (nodes[child].visits == 0)
+            return child;
+        float visits = static_cast<float>(nodes[child].visits);
+        float score = (nodes[child].value / visits) + (EXPLORATION * std::sqrt(logVisits / visits));
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+// Random moves that don't end the game under the sim's rules, rewarded for staying alive and more so for eating
+float MctsPlayer::rollout(Worker &worker)
+{
+    Simulation &sim = worker.sim;
+    const RuleSet &rules = sim.getRules();
+    int xTiles = sim.getXTiles(), yTiles = sim.getYTiles();
+    for (std::uint32_t depth = 0; depth < pRolloutDepth && sim.isAlive(); ++depth)
+    {
+        vec2d head = sim.getHeadTile();
+        std::uint32_t pick = worker.rng();
+        DIRECTION move = directions[pick & 3];
+        for (int tries = 0; tries < 4; ++tries)
+        {
+            int i = (pick + tries) & 3;
+            int x = head.x + directionX[i], y = head.y + directionY[i];
+            if (x < 0 || x >= xTiles || y < 0 || y >= yTiles)
+            {
+                // Blocked walls only stall the snake, a wasted move all the same
+                if (rules.walls != WALL_RULE::WRAP)
+                    continue;
+                x = (x + xTiles) % xTiles;
+                y = (y + yTiles) % yTiles;
+            }
+            CELL cell = sim.getCell(x, y);
+            if (cell != CELL::BODY && (cell != CELL::NECK || rules.neck != NECK_RULE::DEATH))
+            {
+                move = directions[i];
+                break;
+            }
+        }
+        sim.step(move);
+    }
+
+    if (!sim.isAlive())
+        return 0.0f;
+    float gained = static_cast<float>(sim.getScore() - pRootScore);
+    return 0.5f + (0.5f * (gained / (gained + 1.0f)));
+}
+
+std::uint64_t MctsPlayer::getRollouts() const
+{
+    return pRollouts;
+}
+
+double MctsPlayer::getSearchSeconds() const
+{
+    return pSearchSeconds;
+}
+
+double MctsPlayer::getRolloutsPerSecond() const
+{
+    return (pSearchSeconds > 0.0) ? pRollouts / pSearchSeconds : 0.0;
+}
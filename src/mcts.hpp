@@ -0,0 +1,101 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef MCTS_HPP
+#define MCTS_HPP
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+#include "simulation.hpp"
+
+// Monte Carlo tree search player with root parallelization: every thread grows its own
+// tree from the current state until the time budget runs out, then the visits of the
+// root's moves are added up and the most visited one is played.
+//
+// Every iteration starts from the root's raw snapshot (see Simulation::writeSnapshot),
+// restoring the thread's Simulation is a handful of memcpys. Nodes live in a per thread
+// array reserved up front, children are allocated four at a time (one per direction)
+// and the whole tree is dropped by clearing the array
+class MctsPlayer
+{
+private:
+    struct Node
+    {
+        std::uint32_t firstChild; // NO_NODE until expanded
+        std::uint32_t visits;
+        float value;
+        DIRECTION move;
+    };
+
+    // Each search thread's state, only touched by its own thread while searching
+    struct Worker
+    {
+        Simulation sim;
+        std::vector<Node> nodes;
+        std::vector<std::uint32_t> path;
+        std::mt19937 rng;
+        std::uint64_t rollouts;
+
+        Worker(std::uint16_t xTiles, std::uint16_t yTiles, const RuleSet &rules) : sim(xTiles, yTiles, rules), rollouts(0) {}
+    };
+
+    std::uint32_t pBudgetMicroseconds, pRolloutDepth, pMaxNodes;
+    std::vector<std::unique_ptr<Worker>> pWorkers;
+
+    // Shared by every worker during a search, read only
+    std::vector<std::uint8_t> pRoot;
+    std::uint32_t pRootScore;
+    std::chrono::steady_clock::time_point pDeadline;
+
+    // Persistent threads, woken up once per decision. Worker 0 is the caller's thread
+    std::vector<std::thread> pThreads;
+    std::mutex pMutex;
+    std::condition_variable pStart, pDone;
+    std::uint64_t pGeneration;
+    std::uint32_t pPending;
+    bool pQuit;
+
+    std::uint64_t pRollouts;
+    double pSearchSeconds;
+
+    void threadLoop(std::uint32_t index);
+    void search(Worker &worker);
+    void expand(Worker &worker, std::uint32_t node);
+    std::uint32_t select(const Worker &worker, std::uint32_t node) const;
+    float rollout(Worker &worker);
+
+public:
+    static const std::uint32_t NO_NODE = 0xFFFFFFFF;
+
+    // Rollouts play by the given rules, threads includes the caller's (at least 1).
+    // Throws std::invalid_argument on an invalid board or rule set
+    MctsPlayer(std::uint16_t xTiles, std::uint16_t yTiles, const RuleSet &rules, std::uint32_t threads, std::uint32_t budgetMicroseconds,
+               std::uint32_t rolloutDepth = 32, std::uint32_t maxNodes = 1 << 16);
+    ~MctsPlayer();
+    MctsPlayer(const MctsPlayer &) = delete;
+    MctsPlayer &operator=(const MctsPlayer &) = delete;
+
+    // Searches for the time budget and returns the best move for sim's current state
+    DIRECTION nextMove(const Simulation &sim, DIRECTION lastMove);
+
+    // Totals over every decision so far, for sizing how many bots a machine can run
+    std::uint64_t getRollouts() const;
+    double getSearchSeconds() const;
+    double getRolloutsPerSecond() const;
+};
+
+#endif
@@ -0,0 +1,267 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <cstring>
+#include "observation.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define OBSERVATION_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Bitboard to bytes (0 or 255) and bytes to scaled floats, from the first value on
+typedef void (*ExpandKernel)(const std::uint32_t *bits, std::uint32_t begin, std::uint32_t count, std::uint8_t *out);
+typedef void (*ConvertKernel)(const std::uint8_t *in, std::uint32_t begin, std::uint32_t count, float *out, float scale);
+
+// Reference kernels, the vector ones finish their tails with them
+static void expandScalar(const std::uint32_t *bits, std::uint32_t begin, std::uint32_t count, std::uint8_t *out)
+{
+    for (std::uint32_t i = begin; i < count; ++i)
+        out[i] = ((bits[i >> 5] >> (i & 31)) & 1) ? 255 : 0;
+}
+
+static void convertScalar(const std::uint8_t *in, std::uint32_t begin, std::uint32_t count, float *out, float scale)
+{
+    for (std::uint32_t i = begin; i < count; ++i)
+        out[i] = in[i] * scale;
+}
+
+#ifdef OBSERVATION_SIMD_X86
+
+__attribute__((target("sse4.1")))
+static void expandSSE41(const std::uint32_t *bits, std::uint32_t begin, std::uint32_t count, std::uint8_t *out)
+{
+    // Every byte gets the bitboard byte holding its bit, then tests its own bit in it
+    const __m128i low = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+    const __m128i high = _mm_setr_epi8(2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m128i mask = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ull));
+
+    std::uint32_t i = begin;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m128i word = _mm_set1_epi32(static_cast<int>(bits[i >> 5]));
+        __m128i first = _mm_and_si128(_mm_shuffle_epi8(word, low), mask);
+        __m128i second = _mm_and_si128(_mm_shuffle_epi8(word, high), mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_cmpeq_epi8(first, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 16), _mm_cmpeq_epi8(second, mask));
+    }
+    expandScalar(bits, i, count, out);
+}
+
+__attribute__((target("sse4.1")))
+static void convertSSE41(const std::uint8_t *in, std::uint32_t begin, std::uint32_t count, float *out, float scale)
+{
+    const __m128 factor = _mm_set1_ps(scale);
+    std::uint32_t i = begin;
+    for (; i + 4 <= count; i += 4)
+    {
+        std::int32_t raw;
+        std::memcpy(&raw, in + i, 4);
+        __m128 values = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(raw)));
+        _mm_storeu_ps(out + i, _mm_mul_ps(values, factor));
+    }
+    convertScalar(in, i, count, out, scale);
+}
+
+__attribute__((target("avx2")))
+static void expandAVX2(const std::uint32_t *bits, std::uint32_t begin, std::uint32_t count, std::uint8_t *out)
+{
+    // Byte shuffles stay within 128 bit lanes, the word is broadcast to both
+    const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ull));
+
+    std::uint32_t i = begin;
+    for (; i + 32 <= count; i += 32)
+    {
+        __m256i bytes = _mm256_and_si256(_mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits[i >> 5])), spread), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_cmpeq_epi8(bytes, mask));
+    }
+    expandScalar(bits, i, count, out);
+}
+
+__attribute__((target("avx2")))
+static void convertAVX2(const std::uint8_t *in, std::uint32_t begin, std::uint32_t count, float *out, float scale)
+{
+    const __m256 factor = _mm256_set1_ps(scale);
+    std::uint32_t i = begin;
+    for (; i + 8 <= count; i += 8)
+    {
+        long long raw;
+        std::memcpy(&raw, in + i, 8);
+        __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_cvtsi64_si128(raw)));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(values, factor));
+    }
+    convertScalar(in, i, count, out, scale);
+}
+
+#endif
+
+struct ObservationKernelEntry
+{
+    ExpandKernel expand;
+    ConvertKernel convert;
+    std::string name;
+};
+
+// Best kernels the CPU supports, picked on first use
+static const ObservationKernelEntry &observationKernel()
+{
+    static const ObservationKernelEntry entry = []()
+    {
+#ifdef OBSERVATION_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return ObservationKernelEntry{expandAVX2, convertAVX2, "avx2"};
+        if (__builtin_cpu_supports("sse4.1"))
+            return ObservationKernelEntry{expandSSE41, convertSSE41, "sse4.1"};
+#endif
+        return ObservationKernelEntry{expandScalar, convertScalar, "scalar"};
+    }();
+    return entry;
+}
+
+ObservationRasterizer::ObservationRasterizer(const BatchSimulation &batch, std::uint32_t threads)
+    : pBatch(batch)
+{
+    std::uint16_t xTiles = batch.getXTiles(), yTiles = batch.getYTiles();
+    pTiles = static_cast<std::uint32_t>(xTiles) * yTiles;
+    pBytes = nullptr;
+    pFloats = nullptr;
+    pGeneration = 0;
+    pPending = 0;
+    pQuit = false;
+
+    // Same order as the WALL_ planes, a single tile wide board is blocked both ways
+    pWalls.assign(static_cast<std::size_t>(pTiles) * 4, 0);
+    std::uint8_t *up = pWalls.data(), *down = up + pTiles, *left = down + pTiles, *right = left + pTiles;
+    for (std::uint32_t tile = 0; tile < pTiles; ++tile)
+    {
+        std::uint32_t x = tile % xTiles, y = tile / xTiles;
+        up[tile] = (y == 0) ? 255 : 0;
+        down[tile] = (y == yTiles - 1u) ? 255 : 0;
+        left[tile] = (x == 0) ? 255 : 0;
+        right[tile] = (x == xTiles - 1u) ? 255 : 0;
+    }
+
+    if (threads == 0)
+        threads = 1;
+    pScratch.assign(threads, std::vector<std::uint8_t>(getObservationSize()));
+    for (std::uint32_t i = 1; i < threads; ++i)
+        pThreads.emplace_back(&ObservationRasterizer::threadLoop, this, i);
+}
+
+ObservationRasterizer::~ObservationRasterizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pQuit = true;
+    }
+    pStart.notify_all();
+    for (auto &thread : pThreads)
+        thread.join();
+}
+
+std::size_t ObservationRasterizer::getObservationSize() const
+{
+    return static_cast<std::size_t>(pTiles) * static_cast<std::size_t>(PLANE::END_ENUM);
+}
+
+void ObservationRasterizer::rasterize(std::uint8_t *out)
+{
+    pBytes = out;
+    pFloats = nullptr;
+    run();
+}
+
+void ObservationRasterizer::rasterize(float *out)
+{
+    pBytes = nullptr;
+    pFloats = out;
+    run();
+}
+
+void ObservationRasterizer::threadLoop(std::uint32_t index)
+{
+    std::uint64_t generation = 0;
+    for (;;)
+    {
+        std::unique_lock<std::mutex> lock(pMutex);
+        pStart.wait(lock, [&] { return pQuit || pGeneration != generation; });
+        if (pQuit)
+            return;
+        generation = pGeneration;
+        lock.unlock();
+
+        rasterizeGames(index);
+
+        lock.lock();
+        if (--pPending == 0)
+            pDone.notify_one();
+    }
+}
+
+void ObservationRasterizer::run()
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pPending = static_cast<std::uint32_t>(pThreads.size());
+        pGeneration++;
+    }
+    pStart.notify_all();
+    rasterizeGames(0);
+
+    std::unique_lock<std::mutex> lock(pMutex);
+    pDone.wait(lock, [&] { return pPending == 0; });
+}
+
+// Every thread takes a contiguous share of the games, they all cost about the same
+void ObservationRasterizer::rasterizeGames(std::uint32_t thread)
+{
+    std::uint64_t games = pBatch.getGames(), threads = pScratch.size();
+    std::uint32_t begin = static_cast<std::uint32_t>((games * thread) / threads);
+    std::uint32_t end = static_cast<std::uint32_t>((games * (thread + 1)) / threads);
+    std::size_t size = getObservationSize();
+
+    for (std::uint32_t game = begin; game < end; ++game)
+    {
+        if (pBytes)
+            rasterizeGame(game, pBytes + (game * size));
+        else
+        {
+            rasterizeGame(game, pScratch[thread].data());
+            observationKernel().convert(pScratch[thread].data(), 0, static_cast<std::uint32_t>(size), pFloats + (game * size), 1.0f / 255.0f);
+        }
+    }
+}
+
+void ObservationRasterizer::rasterizeGame(std::uint32_t game, std::uint8_t *out) const
+{
+    std::uint8_t *head = out + (pTiles * static_cast<std::size_t>(PLANE::HEAD));
+    std::uint8_t *body = out + (pTiles * static_cast<std::size_t>(PLANE::BODY));
+    std::uint8_t *food = out + (pTiles * static_cast<std::size_t>(PLANE::FOOD));
+    std::uint8_t *walls = out + (pTiles * static_cast<std::size_t>(PLANE::WALL_UP));
+
+    // Head and body planes are next to each other, cleared in one go
+    std::memset(head, 0, pTiles * 2);
+    std::uint32_t length = pBatch.getLength(game);
+    head[pBatch.getSegment(game, 0)] = 255;
+    for (std::uint32_t segment = 0; segment < length; ++segment)
+        body[pBatch.getSegment(game, segment)] = static_cast<std::uint8_t>(((255 * (length - segment)) + length - 1) / length);
+
+    observationKernel().expand(pBatch.getFoodBoard(game), 0, pTiles, food);
+    std::memcpy(walls, pWalls.data(), pWalls.size());
+}
+
+std::string ObservationRasterizer::getKernelName()
+{
+    return observationKernel().name;
+}
@@ -0,0 +1,90 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef OBSERVATION_HPP
+#define OBSERVATION_HPP
+
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+#include "batchSimulation.hpp"
+
+// Observation planes, each one is a row major board (xTiles * yTiles values)
+enum class PLANE : std::int8_t
+{
+    HEAD = 0,  // Full value on the head's tile
+    BODY = 1,  // Every segment head included, valued by how many moves it has left before the
+               // tail frees it: full at the head, 1 / length at the tail
+    FOOD = 2,  // Full value on every piece of food
+    // Blocked moves, one plane per DIRECTION in its order: full value on the tiles where
+    // moving that way runs into the board's edge. Edge tiles themselves are playable
+    WALL_UP = 3,
+    WALL_DOWN = 4,
+    WALL_LEFT = 5,
+    WALL_RIGHT = 6,
+    END_ENUM = 7
+};
+
+// Turns a whole BatchSimulation into stacked observation planes for training, laid out
+// game after game with PLANE::END_ENUM planes each. uint8 planes go from 0 to 255, float
+// ones from 0 to 1. Nothing is rendered, the planes come straight from the game state:
+// the food plane is expanded from the food bitboards and float planes converted with
+// the same SSE4.1 / AVX2 / plain C++ kernel selection as BatchSimulation, the snakes
+// are scattered in. Games are split between the calling thread and threads - 1 workers
+// that stay around between calls
+class ObservationRasterizer
+{
+private:
+    const BatchSimulation &pBatch;
+    std::uint32_t pTiles;
+    std::vector<std::uint8_t> pWalls; // The four wall planes, constant, copied in for every game
+
+    // One uint8 plane set per thread, float output is converted from it
+    std::vector<std::vector<std::uint8_t>> pScratch;
+
+    // Current job, read only for the workers
+    std::uint8_t *pBytes;
+    float *pFloats;
+
+    std::vector<std::thread> pThreads;
+    std::mutex pMutex;
+    std::condition_variable pStart, pDone;
+    std::uint64_t pGeneration;
+    std::uint32_t pPending;
+    bool pQuit;
+
+    void threadLoop(std::uint32_t index);
+    void run();
+    void rasterizeGames(std::uint32_t thread);
+    void rasterizeGame(std::uint32_t game, std::uint8_t *out) const;
+
+public:
+    // The batch must outlive the rasterizer, threads includes the caller's
+    ObservationRasterizer(const BatchSimulation &batch, std::uint32_t threads = 1);
+    ~ObservationRasterizer();
+    ObservationRasterizer(const ObservationRasterizer &) = delete;
+    ObservationRasterizer &operator=(const ObservationRasterizer &) = delete;
+
+    // Values per game, every plane of it
+    std::size_t getObservationSize() const;
+
+    // out holds getGames() * getObservationSize() values
+    void rasterize(std::uint8_t *out);
+    void rasterize(float *out);
+
+    // Name of the vector kernel in use
+    static std::string getKernelName();
+};
+
+#endif
@@ -0,0 +1,174 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <cstdlib>
+#include "policy.hpp"
+#include "arena.hpp"
+
+static const DIRECTION directions[4] = {DIRECTION::UP, DIRECTION::DOWN, DIRECTION::LEFT, DIRECTION::RIGHT};
+static const int directionX[4] = {0, 0, -1, 1};
+static const int directionY[4] = {-1, 1, 0, 0};
+
+static DIRECTION opposite(DIRECTION dir)
+{
+    switch (dir)
+    {
+    case DIRECTION::UP:
+        return DIRECTION::DOWN;
+    case DIRECTION::DOWN:
+        return DIRECTION::UP;
+    case DIRECTION::LEFT:
+        return DIRECTION::RIGHT;
+    case DIRECTION::RIGHT:
+        return DIRECTION::LEFT;
+    default:
+        return DIRECTION::NO_DIRECTION;
+    }
+}
+
+static DIRECTION randomMove(DIRECTION lastMove, std::mt19937 &rng)
+{
+    DIRECTION dir;
+    do
+        dir = directions[rng() & 3];
+    while (dir == opposite(lastMove));
+    return dir;
+}
+
+// The policies only look at one snake's head and the board, Simulation fits as is and
+// Arena gets wrapped so they can be shared by both
+struct ArenaView
+{
+    const Arena &arena;
+    std::uint32_t snake;
+
+    vec2d getHeadTile() const { return arena.getHeadTile(snake); }
+    std::uint16_t getXTiles() const { return arena.getXTiles(); }
+    std::uint16_t getYTiles() const { return arena.getYTiles(); }
+    CELL getCell(int x, int y) const { return arena.getCell(x, y); }
+    const std::vector<FoodItem> &getFood() const { return arena.getFood(); }
+};
+
+template <typename Board>
+static DIRECTION greedyMove(const Board &sim, DIRECTION lastMove)
+{
+    vec2d head = sim.getHeadTile();
+    int xTiles = sim.getXTiles(), yTiles = sim.getYTiles();
+
+    // Closest food, manhattan distance
+    int targetX = head.x, targetY = head.y, best = -1;
+    for (const FoodItem &food : sim.getFood())
+    {
+        int x = food.tile % xTiles, y = food.tile / xTiles;
+        int distance = std::abs(x - head.x) + std::abs(y - head.y);
+        if (best < 0 || distance < best)
+        {
+            best = distance;
+            targetX = x;
+            targetY = y;
+        }
+    }
+
+    // Safe move that gets the closest to the target
+    DIRECTION move = lastMove;
+    best = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        int x = head.x + directionX[i], y = head.y + directionY[i];
+        if (x < 0 || x >= xTiles || y < 0 || y >= yTiles)
+            continue;
+        CELL cell = sim.getCell(x, y);
+        if (cell != CELL::EMPTY && cell != CELL::FOOD)
+            continue;
+        int distance = std::abs(targetX - x) + std::abs(targetY - y);
+        if (best < 0 || distance < best)
+        {
+            best = distance;
+            move = directions[i];
+        }
+    }
+    return move;
+}
+
+// Hamiltonian cycle over an even width board, row 0 is the way back to the start
+template <typename Board>
+static DIRECTION cycleMove(const Board &sim)
+{
+    vec2d head = sim.getHeadTile();
+    int w = sim.getXTiles(), h = sim.getYTiles();
+
+    if (head.y == 0)
+        return (head.x > 0) ? DIRECTION::LEFT : DIRECTION::DOWN;
+    if (head.x % 2 == 0)
+        return (head.y == h - 1) ? DIRECTION::RIGHT : DIRECTION::DOWN;
+    if (head.x == w - 1)
+        return DIRECTION::UP;
+    return (head.y == 1) ? DIRECTION::RIGHT : DIRECTION::UP;
+}
+
+bool policyFromString(const std::string &name, POLICY &policy)
+{
+    for (int i = 0; i < static_cast<int>(POLICY::END_ENUM); ++i)
+    {
+        if (name == policyToString(static_cast<POLICY>(i)))
+        {
+            policy = static_cast<POLICY>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string policyToString(POLICY policy)
+{
+    switch (policy)
+    {
+    case POLICY::RANDOM:
+        return "random";
+    case POLICY::GREEDY:
+        return "greedy";
+    case POLICY::CYCLE:
+        return "cycle";
+    case POLICY::PATH:
+        return "path";
+    case POLICY::MCTS:
+        return "mcts";
+    default:
+        return "unknown";
+    }
+}
+
+template <typename Board>
+static DIRECTION policyMove(POLICY policy, const Board &sim, DIRECTION lastMove, std::mt19937 &rng)
+{
+    switch (policy)
+    {
+    case POLICY::RANDOM:
+        return randomMove(lastMove, rng);
+    case POLICY::GREEDY:
+    case POLICY::PATH:
+    case POLICY::MCTS:
+        return greedyMove(sim, lastMove);
+    case POLICY::CYCLE:
+        return cycleMove(sim);
+    default:
+        return lastMove;
+    }
+}
+
+DIRECTION choosePolicyMove(POLICY policy, const Simulation &sim, DIRECTION lastMove, std::mt19937 &rng)
+{
+    return policyMove(policy, sim, lastMove, rng);
+}
+
+DIRECTION choosePolicyMove(POLICY policy, const Arena &arena, std::uint32_t snake, DIRECTION lastMove, std::mt19937 &rng)
+{
+    return policyMove(policy, ArenaView{arena, snake}, lastMove, rng);
+}
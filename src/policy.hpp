@@ -0,0 +1,42 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef POLICY_HPP
+#define POLICY_HPP
+
+#include <string>
+#include <random>
+#include <cstdint>
+#include "simulation.hpp"
+
+class Arena;
+
+// Scripted players used to drive the simulation without a human at the keyboard
+enum class POLICY : std::int8_t
+{
+    RANDOM = 0, // Uniformly random turns, never reverses
+    GREEDY = 1, // Heads for the closest food, avoids walls and its own body one move ahead
+    CYCLE = 2,  // Follows a hamiltonian cycle, never dies (needs an even board width)
+    PATH = 3,   // Shortest path to food, see Autopilot. Keeps state, choosePolicyMove() plays it as GREEDY
+    MCTS = 4,   // Monte Carlo tree search, see MctsPlayer. Same as PATH for choosePolicyMove()
+    END_ENUM = 5
+};
+
+// Returns false if the name doesn't match any policy
+bool policyFromString(const std::string &name, POLICY &policy);
+std::string policyToString(POLICY policy);
+
+// Picks the next move, rng is the policy's own generator so the game's food
+// placement doesn't depend on the policy's choices
+DIRECTION choosePolicyMove(POLICY policy, const Simulation &sim, DIRECTION lastMove, std::mt19937 &rng);
+// Same for one of the snakes on a shared board, the cycle policy only works with a single snake
+DIRECTION choosePolicyMove(POLICY policy, const Arena &arena, std::uint32_t snake, DIRECTION lastMove, std::mt19937 &rng);
+
+#endif
@@ -0,0 +1,325 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include "replay.hpp"
+
+static const char REPLAY_MAGIC[4] = {'S', 'N', 'K', 'R'};
+static const std::uint8_t REPLAY_VERSION = 2;
+
+static void putBytes(std::vector<std::uint8_t> &out, std::uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+static bool getBytes(const std::vector<std::uint8_t> &in, std::size_t &offset, std::uint32_t &value, int bytes)
+{
+    if (in.size() - offset < static_cast<std::size_t>(bytes))
+        return false;
+    value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= static_cast<std::uint32_t>(in[offset++]) << (8 * i);
+    return true;
+}
+
+// Unsigned LEB128, 7 bits per byte with the high bit set on every byte but the last
+static void putVarint(std::vector<std::uint8_t> &out, std::uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+static bool getVarint(const std::vector<std::uint8_t> &in, std::uint32_t &offset, std::uint32_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35 && offset < in.size(); shift += 7)
+    {
+        std::uint8_t byte = in[offset++];
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+ReplayRecorder::ReplayRecorder()
+{
+    pWidth = pHeight = 0;
+    pSeed = pTicks = 0;
+    pKeyframeInterval = 1024;
+    pScore = 0;
+    pKeyframeCount = 0;
+    pRunDirection = DIRECTION::NO_DIRECTION;
+    pRunLength = 0;
+}
+
+void ReplayRecorder::start(const Simulation &sim, std::uint32_t keyframeInterval)
+{
+    pWidth = sim.getXTiles();
+    pHeight = sim.getYTiles();
+    pSeed = sim.getSeed();
+    pTicks = 0;
+    pKeyframeInterval = (keyframeInterval == 0) ? 1 : keyframeInterval;
+    pScore = sim.getScore();
+    pRuns.clear();
+    pKeyframeCount = 0;
+    pRunDirection = DIRECTION::NO_DIRECTION;
+    pRunLength = 0;
+}
+
+void ReplayRecorder::record(const Simulation &sim, DIRECTION dir)
+{
+    // A new run starts every time the direction changes
+    if (pRunLength > 0 && dir != pRunDirection)
+    {
+        flushRun(pRuns);
+        pRunLength = 0;
+    }
+    pRunDirection = dir;
+
+    if (pTicks % pKeyframeInterval == 0)
+    {
+        // The current run isn't written yet, it will land at the end of the stream
+        if (pKeyframeCount == pKeyframes.size())
+            pKeyframes.emplace_back();
+        ReplayKeyframe &keyframe = pKeyframes[pKeyframeCount++];
+        keyframe.tick = pTicks;
+        keyframe.runOffset = pRuns.size();
+        keyframe.runConsumed = pRunLength;
+        keyframe.state.clear();
+        sim.saveState(keyframe.state);
+    }
+
+    pRunLength++;
+    pTicks++;
+}
+
+void ReplayRecorder::unrecord()
+{
+    if (pTicks == 0)
+        return;
+    pRunLength--;
+    pTicks--;
+
+    if (pRunLength == 0 && !pRuns.empty())
+    {
+        // Reopen the last written run so the next tick can extend it, like record() would have.
+        // Its varint ends right before the direction and every byte of it but the last has
+        // the high bit set
+        pRunDirection = static_cast<DIRECTION>(pRuns.back());
+        pRuns.pop_back();
+        std::uint32_t start = pRuns.size() - 1;
+        while (start > 0 && (pRuns[start - 1] & 0x80))
+            --start;
+        std::uint32_t offset = start;
+        getVarint(pRuns, offset, pRunLength);
+        pRuns.resize(start);
+    }
+
+    // Keyframes are taken before their tick is played, that one is gone too
+    while (pKeyframeCount > 0 && pKeyframes[pKeyframeCount - 1].tick >= pTicks)
+        pKeyframeCount--;
+}
+
+void ReplayRecorder::finish(const Simulation &sim)
+{
+    pScore = sim.getScore();
+}
+
+void ReplayRecorder::flushRun(std::vector<std::uint8_t> &runs) const
+{
+    putVarint(runs, pRunLength);
+    runs.push_back(static_cast<std::uint8_t>(pRunDirection));
+}
+
+std::uint32_t ReplayRecorder::getTicks() const
+{
+    return pTicks;
+}
+
+bool ReplayRecorder::save(const std::string &path) const
+{
+    std::vector<std::uint8_t> runs = pRuns;
+    if (pRunLength > 0)
+        flushRun(runs);
+
+    std::vector<std::uint8_t> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    putBytes(out, REPLAY_VERSION, 1);
+    putBytes(out, pWidth, 2);
+    putBytes(out, pHeight, 2);
+    putBytes(out, pSeed, 4);
+    putBytes(out, pTicks, 4);
+    putBytes(out, pKeyframeInterval, 4);
+    putBytes(out, pScore, 4);
+    putBytes(out, runs.size(), 4);
+    putBytes(out, pKeyframeCount, 4);
+    out.insert(out.end(), runs.begin(), runs.end());
+    for (std::uint32_t i = 0; i < pKeyframeCount; ++i)
+    {
+        const ReplayKeyframe &keyframe = pKeyframes[i];
+        putBytes(out, keyframe.tick, 4);
+        putBytes(out, keyframe.runOffset, 4);
+        putBytes(out, keyframe.runConsumed, 4);
+        putBytes(out, keyframe.state.size(), 4);
+        out.insert(out.end(), keyframe.state.begin(), keyframe.state.end());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char *>(out.data()), out.size());
+    return static_cast<bool>(file);
+}
+
+ReplayPlayer::ReplayPlayer()
+{
+    pWidth = pHeight = 0;
+    pSeed = pTicks = 0;
+    pKeyframeInterval = 0;
+    pScore = 0;
+    pTick = pRunOffset = pRunRemaining = 0;
+    pRunDirection = DIRECTION::NO_DIRECTION;
+}
+
+bool ReplayPlayer::load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::vector<std::uint8_t> in((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::size_t offset = 4;
+    std::uint32_t version, width, height, runSize, keyframes;
+    if (in.size() < 4 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, in.begin()) ||
+        !getBytes(in, offset, version, 1) || version != REPLAY_VERSION ||
+        !getBytes(in, offset, width, 2) || !getBytes(in, offset, height, 2) ||
+        !getBytes(in, offset, pSeed, 4) || !getBytes(in, offset, pTicks, 4) ||
+        !getBytes(in, offset, pKeyframeInterval, 4) || !getBytes(in, offset, pScore, 4) ||
+        !getBytes(in, offset, runSize, 4) || !getBytes(in, offset, keyframes, 4) ||
+        in.size() - offset < runSize)
+        return false;
+    pWidth = width;
+    pHeight = height;
+    pRuns.assign(in.begin() + offset, in.begin() + offset + runSize);
+    offset += runSize;
+
+    pKeyframes.clear();
+    for (std::uint32_t i = 0; i < keyframes; ++i)
+    {
+        ReplayKeyframe keyframe;
+        std::uint32_t stateSize;
+        if (!getBytes(in, offset, keyframe.tick, 4) || !getBytes(in, offset, keyframe.runOffset, 4) ||
+            !getBytes(in, offset, keyframe.runConsumed, 4) || !getBytes(in, offset, stateSize, 4) ||
+            in.size() - offset < stateSize)
+            return false;
+        keyframe.state.assign(in.begin() + offset, in.begin() + offset + stateSize);
+        offset += stateSize;
+        pKeyframes.push_back(std::move(keyframe));
+    }
+
+    try
+    {
+        pSim.reset(new Simulation(pWidth, pHeight));
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+    return seek(0);
+}
+
+bool ReplayPlayer::readRun()
+{
+    std::uint32_t length;
+    if (!getVarint(pRuns, pRunOffset, length) || pRunOffset >= pRuns.size())
+        return false;
+    pRunDirection = static_cast<DIRECTION>(pRuns[pRunOffset++]);
+    pRunRemaining = length;
+    return true;
+}
+
+bool ReplayPlayer::step()
+{
+    if (!pSim || pTick >= pTicks)
+        return false;
+    while (pRunRemaining == 0)
+        if (!readRun())
+            return false;
+
+    pSim->step(pRunDirection);
+    pRunRemaining--;
+    pTick++;
+    return true;
+}
+
+bool ReplayPlayer::seek(std::uint32_t tick)
+{
+    if (!pSim || tick > pTicks)
+        return false;
+
+    // Closest keyframe at or before the tick, the keyframes are sorted
+    const ReplayKeyframe *start = nullptr;
+    for (const ReplayKeyframe &keyframe : pKeyframes)
+    {
+        if (keyframe.tick > tick)
+            break;
+        start = &keyframe;
+    }
+
+    if (start && pSim->loadState(start->state.data(), start->state.size()))
+    {
+        pTick = start->tick;
+        pRunOffset = start->runOffset;
+        if (!readRun() || start->runConsumed > pRunRemaining)
+            return false;
+        pRunRemaining -= start->runConsumed;
+    }
+    else
+    {
+        // No usable keyframe, play from the start
+        pSim->reset(pSeed);
+        pTick = 0;
+        pRunOffset = 0;
+        pRunRemaining = 0;
+    }
+
+    while (pTick < tick)
+        if (!step())
+            return false;
+    return true;
+}
+
+std::uint32_t ReplayPlayer::getTick() const
+{
+    return pTick;
+}
+
+std::uint32_t ReplayPlayer::getTicks() const
+{
+    return pTicks;
+}
+
+std::uint32_t ReplayPlayer::getRecordedScore() const
+{
+    return pScore;
+}
+
+const Simulation &ReplayPlayer::getSimulation() const
+{
+    return *pSim;
+}
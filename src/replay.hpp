@@ -0,0 +1,106 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "simulation.hpp"
+
+// Replay files, a game is fully described by its seed and the direction used on
+// every tick. All values are little endian:
+//
+// Header   "SNKR", version (1 byte), width, height (2 bytes), seed, ticks,
+//          keyframe interval, final score (4 bytes),
+//          run stream size, keyframe count (4 bytes)
+// Runs     Direction changes, run length encoded: ticks as a varint followed
+//          by the direction held during them (1 byte)
+// Keyframe Tick, run stream offset, ticks already played from that run,
+//          state size (4 bytes) and the Simulation::saveState() data. Taken
+//          before the tick is played, lets playback seek without replaying
+//          the whole game
+
+struct ReplayKeyframe
+{
+    std::uint32_t tick, runOffset, runConsumed;
+    std::vector<std::uint8_t> state;
+};
+
+// Builds a replay as the game is played
+class ReplayRecorder
+{
+private:
+    std::uint16_t pWidth, pHeight;
+    std::uint32_t pSeed, pTicks, pKeyframeInterval;
+    std::uint32_t pScore;
+    std::vector<std::uint8_t> pRuns;
+    // Only the first pKeyframeCount are part of the replay, the rest are kept from
+    // earlier recordings so their buffers can be reused
+    std::vector<ReplayKeyframe> pKeyframes;
+    std::uint32_t pKeyframeCount;
+    DIRECTION pRunDirection;
+    std::uint32_t pRunLength;
+
+    void flushRun(std::vector<std::uint8_t> &runs) const;
+
+public:
+    ReplayRecorder();
+
+    // Discards the current recording, sim must have just been reset
+    void start(const Simulation &sim, std::uint32_t keyframeInterval = 1024);
+    // Call before every step with the state the tick starts from
+    void record(const Simulation &sim, DIRECTION dir);
+    // Forgets the last recorded tick, for games that were rewound (see RewindBuffer)
+    void unrecord();
+    // Call after the last step so the replay knows the expected result
+    void finish(const Simulation &sim);
+
+    std::uint32_t getTicks() const;
+    bool save(const std::string &path) const;
+};
+
+// Plays a replay back without a window, as fast as the simulation allows
+class ReplayPlayer
+{
+private:
+    std::uint16_t pWidth, pHeight;
+    std::uint32_t pSeed, pTicks, pKeyframeInterval;
+    std::uint32_t pScore;
+    std::vector<std::uint8_t> pRuns;
+    std::vector<ReplayKeyframe> pKeyframes;
+    std::unique_ptr<Simulation> pSim;
+
+    // Playback position
+    std::uint32_t pTick, pRunOffset, pRunRemaining;
+    DIRECTION pRunDirection;
+
+    bool readRun();
+
+public:
+    ReplayPlayer();
+
+    // Returns false if the file is missing or malformed
+    bool load(const std::string &path);
+    // Plays one tick, returns false once the replay is over
+    bool step();
+    // Jumps to the start of a tick, restoring the closest keyframe before it
+    bool seek(std::uint32_t tick);
+
+    std::uint32_t getTick() const;
+    std::uint32_t getTicks() const;
+    // Score the game had when it was recorded
+    std::uint32_t getRecordedScore() const;
+    const Simulation &getSimulation() const;
+};
+
+#endif
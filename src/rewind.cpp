@@ -0,0 +1,62 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <stdexcept>
+#include "rewind.hpp"
+
+RewindBuffer::RewindBuffer(std::uint32_t capacity)
+{
+    if (capacity == 0)
+        throw std::invalid_argument("RewindBuffer::RewindBuffer | The capacity must be greater than zero");
+    pDeltas.resize(capacity);
+    pNext = pSize = 0;
+}
+
+COLLISION RewindBuffer::step(Simulation &sim, DIRECTION dir)
+{
+    COLLISION result = sim.step(dir, pDeltas[pNext]);
+    pNext = (pNext + 1) % pDeltas.size();
+    if (pSize < pDeltas.size())
+        pSize++;
+    return result;
+}
+
+bool RewindBuffer::rewind(Simulation &sim)
+{
+    if (pSize == 0)
+        return false;
+    pNext = (pNext == 0) ? (pDeltas.size() - 1) : (pNext - 1);
+    pSize--;
+    sim.undo(pDeltas[pNext]);
+    return true;
+}
+
+void RewindBuffer::clear()
+{
+    pNext = pSize = 0;
+}
+
+DIRECTION RewindBuffer::getLastMove() const
+{
+    if (pSize == 0)
+        return DIRECTION::NO_DIRECTION;
+    return pDeltas[(pNext == 0) ? (pDeltas.size() - 1) : (pNext - 1)].dir;
+}
+
+std::uint32_t RewindBuffer::getSize() const
+{
+    return pSize;
+}
+
+std::uint32_t RewindBuffer::getCapacity() const
+{
+    return static_cast<std::uint32_t>(pDeltas.size());
+}
@@ -0,0 +1,46 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef REWIND_HPP
+#define REWIND_HPP
+
+#include <vector>
+#include <cstdint>
+#include "simulation.hpp"
+
+// The last ticks of a game as deltas (see TickDelta), so it can be rewound one tick at
+// a time without keeping copies of the board. Memory depends on the history kept, not
+// on the board's size. Search code can use it to try moves and take them back
+class RewindBuffer
+{
+private:
+    std::vector<TickDelta> pDeltas; // Ring buffer, the newest delta is right before pNext
+    std::uint32_t pNext, pSize;
+
+public:
+    // Keeps the last capacity ticks, throws std::invalid_argument if it's 0
+    explicit RewindBuffer(std::uint32_t capacity);
+
+    // Plays a tick on sim and keeps its delta, the oldest one goes once the buffer is full
+    COLLISION step(Simulation &sim, DIRECTION dir);
+    // Takes the newest tick back, sim must be the one it was played on and be left as it
+    // was after it. Returns false once there's nothing left to rewind
+    bool rewind(Simulation &sim);
+    // Forgets every tick, call it whenever sim is reset or loaded
+    void clear();
+
+    // Direction the newest tick was played with, NO_DIRECTION if there are none
+    DIRECTION getLastMove() const;
+    std::uint32_t getSize() const;
+    std::uint32_t getCapacity() const;
+};
+
+#endif
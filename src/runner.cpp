@@ -0,0 +1,311 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include "runner.hpp"
+#include "arena.hpp"
+#include "autopilot.hpp"
+#include "mcts.hpp"
+
+// What ended a single snake game, a dead snake stays where it was before its last move
+static COLLISION gameEnding(const Simulation &sim, DIRECTION lastMove, COLLISION lastResult)
+{
+    if (sim.isAlive())
+        return COLLISION::NO_COLLISION;
+    if (lastResult != COLLISION::SNAKE || sim.getRules().neck != NECK_RULE::DEATH)
+        return lastResult;
+
+    // Deadly neck hits are reported as SNAKE, tell them apart by the tile the head went for
+    vec2d head = sim.getHeadTile();
+    int x = head.x, y = head.y;
+    switch (lastMove)
+    {
+    case DIRECTION::UP:
+        y--;
+        break;
+    case DIRECTION::DOWN:
+        y++;
+        break;
+    case DIRECTION::LEFT:
+        x--;
+        break;
+    case DIRECTION::RIGHT:
+        x++;
+        break;
+    default:
+        return lastResult;
+    }
+    x = (x + sim.getXTiles()) % sim.getXTiles();
+    y = (y + sim.getYTiles()) % sim.getYTiles();
+    return (sim.getCell(x, y) == CELL::NECK) ? COLLISION::NECK : lastResult;
+}
+
+static std::uint64_t packBounds(std::uint32_t begin, std::uint32_t end)
+{
+    return (static_cast<std::uint64_t>(end) << 32) | begin;
+}
+
+WorkStealingRanges::WorkStealingRanges(std::uint32_t items, std::uint32_t workers)
+{
+    pWorkers = (workers == 0) ? 1 : workers;
+    pSlices.reset(new Slice[pWorkers]);
+
+    // Even split to begin with, stealing takes care of the imbalance
+    for (std::uint32_t i = 0; i < pWorkers; ++i)
+    {
+        std::uint32_t begin = static_cast<std::uint32_t>((static_cast<std::uint64_t>(items) * i) / pWorkers);
+        std::uint32_t end = static_cast<std::uint32_t>((static_cast<std::uint64_t>(items) * (i + 1)) / pWorkers);
+        pSlices[i].bounds.store(packBounds(begin, end), std::memory_order_relaxed);
+    }
+}
+
+bool WorkStealingRanges::next(std::uint32_t worker, std::uint32_t &item)
+{
+    std::atomic<std::uint64_t> &own = pSlices[worker].bounds;
+    std::uint64_t bounds = own.load(std::memory_order_acquire);
+    while (static_cast<std::uint32_t>(bounds) < static_cast<std::uint32_t>(bounds >> 32))
+    {
+        std::uint32_t begin = static_cast<std::uint32_t>(bounds);
+        if (own.compare_exchange_weak(bounds, packBounds(begin + 1, static_cast<std::uint32_t>(bounds >> 32)),
+                                      std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            item = begin;
+            return true;
+        }
+    }
+    return steal(worker, item);
+}
+
+bool WorkStealingRanges::steal(std::uint32_t worker, std::uint32_t &item)
+{
+    for (std::uint32_t i = 1; i < pWorkers; ++i)
+    {
+        std::atomic<std::uint64_t> &victim = pSlices[(worker + i) % pWorkers].bounds;
+        std::uint64_t bounds = victim.load(std::memory_order_acquire);
+        while (static_cast<std::uint32_t>(bounds) < static_cast<std::uint32_t>(bounds >> 32))
+        {
+            // Take the back half, rounded up so a single item can be stolen too
+            std::uint32_t begin = static_cast<std::uint32_t>(bounds), end = static_cast<std::uint32_t>(bounds >> 32);
+            std::uint32_t split = end - ((end - begin + 1) / 2);
+            if (victim.compare_exchange_weak(bounds, packBounds(begin, split),
+                                             std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                // Our own slice is empty, thieves leave it alone until this store
+                item = split;
+                pSlices[worker].bounds.store(packBounds(split + 1, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+GameRunner::GameRunner(const RunnerOptions &options)
+{
+    if (options.policies.empty())
+        throw std::invalid_argument("GameRunner::GameRunner | At least one policy is required");
+    if (options.snakes > 1)
+        Arena validate(options.width, options.height, options.snakes); // Throws on an invalid board
+    else
+        Simulation validate(options.width, options.height, options.rules);
+
+    pOptions = options;
+    if (pOptions.threads == 0)
+        pOptions.threads = 1;
+    pTotals.reset(new PolicyTotals[pOptions.policies.size()]);
+    pLatency.assign(LATENCY_BINS, 0);
+    pSteps = 0;
+    pSeconds = 0.0;
+    pRollouts = 0;
+    pSearchMicroseconds = 0;
+}
+
+void GameRunner::run()
+{
+    WorkStealingRanges queue(pOptions.games, pOptions.threads);
+    std::vector<std::vector<std::uint64_t>> latency(pOptions.threads);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < pOptions.threads; ++i)
+        threads.emplace_back(&GameRunner::worker, this, i, std::ref(queue), std::ref(latency[i]));
+    for (auto &thread : threads)
+        thread.join();
+    pSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The histograms are only merged once every worker is done
+    for (const auto &histogram : latency)
+        for (std::uint32_t i = 0; i < LATENCY_BINS; ++i)
+        {
+            pLatency[i] += histogram[i];
+            pSteps += histogram[i];
+        }
+}
+
+void GameRunner::worker(std::uint32_t index, WorkStealingRanges &queue, std::vector<std::uint64_t> &latency)
+{
+    if (pOptions.snakes > 1)
+    {
+        arenaWorker(index, queue, latency);
+        return;
+    }
+
+    // Thread local arena, allocated once and reused for every game
+    Simulation sim(pOptions.width, pOptions.height, pOptions.rules);
+    Autopilot autopilot(pOptions.width, pOptions.height);
+    std::unique_ptr<MctsPlayer> mcts;
+    for (POLICY policy : pOptions.policies)
+        if (policy == POLICY::MCTS && !mcts)
+            mcts.reset(new MctsPlayer(pOptions.width, pOptions.height, pOptions.rules, pOptions.searchThreads, pOptions.searchBudget));
+    std::mt19937 policyRng;
+    latency.assign(LATENCY_BINS, 0);
+
+    std::uint32_t game;
+    while (queue.next(index, game))
+    {
+        std::size_t policyIndex = game % pOptions.policies.size();
+        POLICY policy = pOptions.policies[policyIndex];
+
+        // Seeded by game, so the results don't depend on which thread plays it
+        sim.reset(pOptions.seed + game);
+        policyRng.seed(pOptions.seed + game);
+        autopilot.reset();
+        DIRECTION move = DIRECTION::NO_DIRECTION;
+        COLLISION result = COLLISION::NO_COLLISION;
+
+        std::uint32_t tick = 0;
+        for (; tick < pOptions.ticks && sim.isAlive(); ++tick)
+        {
+            if (policy == POLICY::PATH)
+                move = autopilot.nextMove(sim, move);
+            else if (policy == POLICY::MCTS)
+                move = mcts->nextMove(sim, move);
+            else
+                move = choosePolicyMove(policy, sim, move, policyRng);
+
+            auto start = std::chrono::steady_clock::now();
+            result = sim.step(move);
+            auto end = std::chrono::steady_clock::now();
+
+            std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            latency[(ns < LATENCY_BINS) ? ns : (LATENCY_BINS - 1)]++;
+        }
+
+        addGame(policyIndex, tick, sim.getScore(), gameEnding(sim, move, result));
+    }
+
+    if (mcts)
+    {
+        pRollouts.fetch_add(mcts->getRollouts(), std::memory_order_relaxed);
+        pSearchMicroseconds.fetch_add(static_cast<std::uint64_t>(mcts->getSearchSeconds() * 1e6), std::memory_order_relaxed);
+    }
+}
+
+void GameRunner::arenaWorker(std::uint32_t index, WorkStealingRanges &queue, std::vector<std::uint64_t> &latency)
+{
+    // Same as worker(), the board and every per snake buffer are reused for all the games
+    Arena arena(pOptions.width, pOptions.height, pOptions.snakes);
+    std::mt19937 policyRng;
+    std::vector<DIRECTION> moves(pOptions.snakes);
+    std::vector<std::uint32_t> lived(pOptions.snakes);
+    latency.assign(LATENCY_BINS, 0);
+
+    std::uint32_t game;
+    while (queue.next(index, game))
+    {
+        arena.reset(pOptions.seed + game);
+        policyRng.seed(pOptions.seed + game);
+        std::fill(moves.begin(), moves.end(), DIRECTION::NO_DIRECTION);
+        std::fill(lived.begin(), lived.end(), 0);
+
+        for (std::uint32_t tick = 0; tick < pOptions.ticks && arena.getAliveCount() > 0; ++tick)
+        {
+            for (std::uint32_t s = 0; s < pOptions.snakes; ++s)
+            {
+                if (!arena.isAlive(s))
+                    continue;
+                moves[s] = choosePolicyMove(pOptions.policies[s % pOptions.policies.size()], arena, s, moves[s], policyRng);
+                lived[s]++;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            arena.step(moves.data());
+            auto end = std::chrono::steady_clock::now();
+
+            std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            latency[(ns < LATENCY_BINS) ? ns : (LATENCY_BINS - 1)]++;
+        }
+
+        for (std::uint32_t s = 0; s < pOptions.snakes; ++s)
+            addGame(s % pOptions.policies.size(), lived[s], arena.getScore(s),
+                    arena.isAlive(s) ? COLLISION::NO_COLLISION : COLLISION::SNAKE);
+    }
+}
+
+void GameRunner::addGame(std::size_t policy, std::uint32_t ticks, std::uint32_t score, COLLISION ending)
+{
+    PolicyTotals &totals = pTotals[policy];
+    totals.games.fetch_add(1, std::memory_order_relaxed);
+    totals.ticks.fetch_add(ticks, std::memory_order_relaxed);
+    totals.score.fetch_add(score, std::memory_order_relaxed);
+    switch (ending)
+    {
+    case COLLISION::NO_COLLISION:
+        totals.timeouts.fetch_add(1, std::memory_order_relaxed);
+        break;
+    case COLLISION::WALL:
+        totals.wallDeaths.fetch_add(1, std::memory_order_relaxed);
+        break;
+    case COLLISION::NECK:
+        totals.neckDeaths.fetch_add(1, std::memory_order_relaxed);
+        break;
+    default:
+        totals.bodyDeaths.fetch_add(1, std::memory_order_relaxed);
+        break;
+    }
+
+    std::uint32_t best = totals.bestScore.load(std::memory_order_relaxed);
+    while (score > best && !totals.bestScore.compare_exchange_weak(best, score, std::memory_order_relaxed))
+        ;
+}
+
+const PolicyTotals &GameRunner::getTotals(std::size_t policy) const
+{
+    return pTotals[policy];
+}
+
+std::uint32_t GameRunner::getLatencyPercentile(double fraction) const
+{
+    std::uint64_t target = static_cast<std::uint64_t>(fraction * pSteps), count = 0;
+    for (std::uint32_t i = 0; i < LATENCY_BINS; ++i)
+    {
+        count += pLatency[i];
+        if (count > target)
+            return i;
+    }
+    return LATENCY_BINS - 1;
+}
+
+double GameRunner::getSeconds() const
+{
+    return pSeconds;
+}
+
+std::uint64_t GameRunner::getRollouts() const
+{
+    return pRollouts;
+}
+
+double GameRunner::getSearchSeconds() const
+{
+    return pSearchMicroseconds / 1e6;
+}
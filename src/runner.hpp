@@ -0,0 +1,109 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef RUNNER_HPP
+#define RUNNER_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include "simulation.hpp"
+#include "policy.hpp"
+
+// What to play, game g is seeded with seed + g and played by policies[g % policies.size()].
+// With more than one snake every game is an Arena, snake s playing policies[s % policies.size()]
+struct RunnerOptions
+{
+    std::uint32_t games, ticks, seed;  // Every game lasts until the snakes die or ticks run out
+    std::uint16_t width, height;       // In tiles, defaults to the windowed game's board
+    std::uint32_t threads;
+    std::uint32_t snakes;
+    std::vector<POLICY> policies;
+    // MCTS decisions, every game thread runs searchThreads of its own
+    std::uint32_t searchThreads, searchBudget; // Budget in microseconds per move
+    RuleSet rules; // Single snake games only, Arena always plays the default rules
+
+    RunnerOptions() : games(100), ticks(10000), seed(1), width(40), height(22), threads(1), snakes(1), policies(1, POLICY::GREEDY),
+                      searchThreads(1), searchBudget(1000) {}
+};
+
+// Results of every game played by a policy, updated lock-free by the workers. Arena
+// games count once per snake, ticks being the ones the snake lived through
+struct PolicyTotals
+{
+    std::atomic<std::uint64_t> games, ticks, score;
+    std::atomic<std::uint64_t> bodyDeaths, wallDeaths, neckDeaths, timeouts; // How the games ended
+    std::atomic<std::uint32_t> bestScore;
+
+    PolicyTotals() : games(0), ticks(0), score(0), bodyDeaths(0), wallDeaths(0), neckDeaths(0), timeouts(0), bestScore(0) {}
+};
+
+// Lock-free work stealing over a range of items. Every worker owns a contiguous
+// slice, takes items from its front and steals half of another slice from its
+// back once its own runs dry
+class WorkStealingRanges
+{
+private:
+    // Begin in the low 32 bits, end in the high ones, so a slice changes with a single CAS.
+    // Padded to a cache line so workers don't contend over their neighbours' slices
+    struct Slice
+    {
+        std::atomic<std::uint64_t> bounds;
+        char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+    };
+    std::unique_ptr<Slice[]> pSlices;
+    std::uint32_t pWorkers;
+
+    bool steal(std::uint32_t worker, std::uint32_t &item);
+
+public:
+    WorkStealingRanges(std::uint32_t items, std::uint32_t workers);
+
+    // Returns false once every slice is empty
+    bool next(std::uint32_t worker, std::uint32_t &item);
+};
+
+// Plays many independent games across threads. Every thread reuses a single
+// Simulation, autopilot and policy generator (its arena) for all the games it runs
+class GameRunner
+{
+private:
+    RunnerOptions pOptions;
+    std::unique_ptr<PolicyTotals[]> pTotals;
+    std::vector<std::uint64_t> pLatency; // Step latency histogram, 1 ns bins
+    std::uint64_t pSteps;
+    std::atomic<std::uint64_t> pRollouts;
+    std::atomic<std::uint64_t> pSearchMicroseconds;
+    double pSeconds;
+
+    void worker(std::uint32_t index, WorkStealingRanges &queue, std::vector<std::uint64_t> &latency);
+    void arenaWorker(std::uint32_t index, WorkStealingRanges &queue, std::vector<std::uint64_t> &latency);
+    // ending is the collision that ended the game, NO_COLLISION if the ticks ran out
+    void addGame(std::size_t policy, std::uint32_t ticks, std::uint32_t score, COLLISION ending);
+
+public:
+    static const std::uint32_t LATENCY_BINS = 100000;
+
+    // Throws std::invalid_argument on an invalid board or too many snakes for it
+    GameRunner(const RunnerOptions &options);
+
+    void run();
+
+    const PolicyTotals &getTotals(std::size_t policy) const;
+    // Smallest step latency in nanoseconds that covers the given fraction of the steps
+    std::uint32_t getLatencyPercentile(double fraction) const;
+    double getSeconds() const;
+    // MCTS rollouts played and time spent searching, summed over every game thread
+    std::uint64_t getRollouts() const;
+    double getSearchSeconds() const;
+};
+
+#endif
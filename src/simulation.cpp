@@ -0,0 +1,850 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include "simulation.hpp"
+
+static const std::uint8_t STATE_VERSION = 3;
+static const char SNAPSHOT_MAGIC[4] = {'S', 'N', 'K', 'S'};
+static const std::uint32_t SNAPSHOT_VERSION = 3;
+
+static_assert(std::is_trivially_copyable<SimulationSnapshot>::value, "Snapshots are copied as raw memory");
+static_assert(std::is_trivially_copyable<FoodItem>::value, "Food is copied as raw memory");
+static_assert(sizeof(SimulationSnapshot) % alignof(SimulationSnapshot) == 0, "The arrays follow the header");
+
+// Where every array lands in a snapshot, see SimulationSnapshot
+struct SnapshotLayout
+{
+    std::size_t snake, freeTiles, tileSlot, occupancy, chunkCount, food, size;
+
+    SnapshotLayout(std::size_t tiles, std::size_t chunks, std::size_t foodCount)
+    {
+        snake = sizeof(SimulationSnapshot);
+        freeTiles = snake + (tiles * sizeof(std::uint32_t));
+        tileSlot = freeTiles + (tiles * sizeof(std::uint32_t));
+        occupancy = tileSlot + (tiles * sizeof(std::uint32_t));
+        chunkCount = occupancy + (chunks * Simulation::CHUNK_SIZE * Simulation::CHUNK_SIZE * sizeof(CELL));
+        food = chunkCount + (((chunks * sizeof(std::uint16_t)) + 3) & ~static_cast<std::size_t>(3));
+        size = food + (foodCount * sizeof(FoodItem));
+    }
+};
+
+// Zobrist keys are generated on the fly rather than stored, a table for every tile and
+// tag would take hundreds of megabytes on the largest boards. Splitmix64's finalizer
+// spreads (tile, feature) well enough, features are the CELL tags plus the tail
+static const std::uint32_t ZOBRIST_TAIL = static_cast<std::uint32_t>(CELL::END_ENUM);
+
+static std::uint64_t zobristKey(std::uint32_t tile, std::uint32_t feature)
+{
+    std::uint64_t key = ((static_cast<std::uint64_t>(tile) << 3) | feature) + 0x9E3779B97F4A7C15ull;
+    key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ull;
+    key = (key ^ (key >> 27)) * 0x94D049BB133111EBull;
+    return key ^ (key >> 31);
+}
+
+// Little endian helpers for saveState() / loadState()
+static void putBytes(std::vector<std::uint8_t> &out, std::uint32_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+static bool getBytes(const std::uint8_t *&data, const std::uint8_t *end, std::uint32_t &value, int bytes)
+{
+    if (end - data < bytes)
+        return false;
+    value = 0;
+    for (int i = 0; i < bytes; ++i)
+        value |= static_cast<std::uint32_t>(*data++) << (8 * i);
+    return true;
+}
+
+Simulation::Simulation(std::uint16_t xTiles, std::uint16_t yTiles, const RuleSet &rules)
+{
+    if (xTiles == 0 || yTiles == 0 || xTiles > MAX_SIDE || yTiles > MAX_SIDE)
+        throw std::invalid_argument("Simulation::Simulation | Both sides of the board must be between 1 and 4096 tiles");
+    pRules = rules;
+    pStep = selectStep(pRules);
+    pDelta = nullptr;
+
+    pXTiles = xTiles;
+    pYTiles = yTiles;
+    pChunksX = (xTiles + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    pChunksY = (yTiles + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    this->reset(0);
+}
+
+void Simulation::reset(std::uint32_t seed)
+{
+    pSeed = seed;
+    pMt.seed(pSeed);
+    pColorSeed = pMt();
+
+    std::uint32_t tiles = static_cast<std::uint32_t>(pXTiles) * pYTiles;
+
+    // The snake can at most cover the entire board, it starts at the top left tile
+    pSnake.assign(tiles, 0);
+    pSnakeHead = 0;
+    pSnakeLength = 1;
+    pGrowth = 0;
+    pAlive = true;
+
+    // Occupancy map and free tile list, only the head is on the board at this point.
+    // Chunks hanging over the board's edges are padded with tiles that are never used
+    pOccupancy.assign(static_cast<std::size_t>(pChunksX) * pChunksY * CHUNK_SIZE * CHUNK_SIZE, CELL::EMPTY);
+    pChunkCount.assign(static_cast<std::size_t>(pChunksX) * pChunksY, 0);
+    pFreeTiles.resize(tiles);
+    pTileSlot.resize(tiles);
+    for (std::uint32_t i = 0; i < tiles; ++i)
+    {
+        pFreeTiles[i] = i;
+        pTileSlot[i] = i;
+    }
+    pFreeTileCount = tiles;
+    pHash = zobristKey(pSnake[pSnakeHead], ZOBRIST_TAIL);
+    setTile(pSnake[pSnakeHead], CELL::HEAD);
+    pTileSlot[pSnake[pSnakeHead]] = pSnakeHead;
+
+    pFood.clear();
+    respawnFood(STARTING_FOOD);
+}
+
+COLLISION Simulation::step(DIRECTION dir)
+{
+    return (this->*pStep)(dir);
+}
+
+COLLISION Simulation::step(DIRECTION dir, TickDelta &delta)
+{
+    // Whatever the tick won't change is written down now, the rest as it happens
+    delta.hash = pHash;
+    delta.tail = delta.headSlot = delta.foodSlot = delta.eatenIndex = NO_TILE;
+    delta.growth = pGrowth;
+    delta.length = pSnakeLength;
+    delta.rngFirst = pMt.state[0];
+    delta.rngIndex = static_cast<std::uint16_t>(pMt.index);
+    delta.eatenKind = 0;
+    delta.dir = dir;
+    delta.alive = pAlive;
+    delta.moved = false;
+
+    pDelta = &delta;
+    COLLISION result = (this->*pStep)(dir);
+    pDelta = nullptr;
+    return result;
+}
+
+void Simulation::undo(const TickDelta &delta)
+{
+    // Backwards from the last change, the free list only comes out right in that order
+    if (delta.foodSlot != NO_TILE)
+    {
+        releaseTile(pFood.back().tile, delta.foodSlot);
+        pFood.pop_back();
+    }
+
+    if (delta.moved)
+    {
+        std::uint32_t capacity = static_cast<std::uint32_t>(pSnake.size());
+        std::uint32_t tile = pSnake[pSnakeHead];
+        if (delta.headSlot != NO_TILE)
+            releaseTile(tile, delta.headSlot);
+        else if (delta.eatenIndex != NO_TILE)
+        {
+            FoodItem food;
+            food.tile = tile;
+            food.kind = delta.eatenKind;
+            pFood.insert(pFood.begin() + delta.eatenIndex, food);
+            pOccupancy[cellIndex(tile)] = CELL::FOOD;
+        }
+
+        // The tail was the last tile freed, it's still at the end of the free list
+        if (delta.tail != NO_TILE)
+        {
+            pFreeTileCount--;
+            pChunkCount[cellIndex(delta.tail) >> (2 * CHUNK_SHIFT)]++;
+        }
+        pSnakeHead = (pSnakeHead + 1) % capacity;
+        pSnakeLength = delta.length;
+
+        // Both ends get their old tags back, nothing in between changed
+        static const CELL segmentCells[3] = {CELL::HEAD, CELL::NECK, CELL::BODY};
+        if (delta.tail != NO_TILE)
+        {
+            // The head may have gone round the ring and written over it since
+            std::uint32_t slot = (pSnakeHead + pSnakeLength - 1) % capacity;
+            pSnake[slot] = delta.tail;
+            pTileSlot[delta.tail] = slot;
+            pOccupancy[cellIndex(delta.tail)] = segmentCells[std::min<std::uint32_t>(pSnakeLength - 1, 2)];
+        }
+        for (std::uint32_t segment = std::min<std::uint32_t>(pSnakeLength, 3); segment-- > 0;)
+            pOccupancy[cellIndex(getSegment(segment))] = segmentCells[segment];
+    }
+
+    // Draws only happen going forward, a regeneration in between has to be reversed too
+    if (pMt.index < delta.rngIndex)
+        pMt.untwist(delta.rngFirst);
+    pMt.index = delta.rngIndex;
+    pGrowth = delta.growth;
+    pAlive = delta.alive;
+    pHash = delta.hash;
+}
+
+template <WALL_RULE Walls, NECK_RULE Neck, std::uint8_t Growth>
+COLLISION Simulation::stepRules(DIRECTION dir)
+{
+    if (!pAlive)
+        return COLLISION::SNAKE;
+
+    int x = pSnake[pSnakeHead] % pXTiles;
+    int y = pSnake[pSnakeHead] / pXTiles;
+    switch (dir)
+    {
+    case DIRECTION::UP:
+        y--;
+        break;
+    case DIRECTION::DOWN:
+        y++;
+        break;
+    case DIRECTION::LEFT:
+        x--;
+        break;
+    case DIRECTION::RIGHT:
+        x++;
+        break;
+    default:
+        return COLLISION::NO_COLLISION; // Waiting for the first input
+    }
+
+    // Against walls, the head is at most one tile past the edge
+    if (x < 0 || x >= pXTiles || y < 0 || y >= pYTiles)
+    {
+        if (Walls == WALL_RULE::WRAP)
+        {
+            x = (x + pXTiles) % pXTiles;
+            y = (y + pYTiles) % pYTiles;
+        }
+        else
+        {
+            if (Walls == WALL_RULE::DEATH)
+                pAlive = false;
+            return COLLISION::WALL;
+        }
+    }
+
+    // Against a body part or food, a single lookup regardless of the snake's length
+    std::uint32_t tile = (static_cast<std::uint32_t>(y) * pXTiles) + x;
+    switch (pOccupancy[cellIndex(x, y)])
+    {
+    case CELL::NECK: // Neck collision, continue forward unless it's deadly
+        if (Neck == NECK_RULE::DEATH)
+        {
+            pAlive = false;
+            return COLLISION::SNAKE;
+        }
+        return COLLISION::NECK;
+    case CELL::BODY:
+        pAlive = false;
+        return COLLISION::SNAKE;
+    case CELL::FOOD:
+        // The new body parts are added by moveSnake(), which skips popping the tail
+        eatFood(tile);
+        pGrowth += Growth;
+        moveSnake(tile);
+        respawnFood(1);
+        return COLLISION::FOOD;
+    default:
+        moveSnake(tile);
+        return COLLISION::NO_COLLISION;
+    }
+}
+
+// Every variant, indexed by wall rule, neck rule and growth - 1
+#define SNAKE_STEP_GROWTHS(WALLS, NECK)                                                                              \
+    {&Simulation::stepRules<WALL_RULE::WALLS, NECK_RULE::NECK, 1>, &Simulation::stepRules<WALL_RULE::WALLS, NECK_RULE::NECK, 2>, \
+     &Simulation::stepRules<WALL_RULE::WALLS, NECK_RULE::NECK, 3>, &Simulation::stepRules<WALL_RULE::WALLS, NECK_RULE::NECK, 4>}
+
+Simulation::StepFunction Simulation::selectStep(const RuleSet &rules)
+{
+    static const StepFunction table[static_cast<int>(WALL_RULE::END_ENUM)][static_cast<int>(NECK_RULE::END_ENUM)][MAX_GROWTH] = {
+        {SNAKE_STEP_GROWTHS(BLOCK, IGNORE), SNAKE_STEP_GROWTHS(BLOCK, DEATH)},
+        {SNAKE_STEP_GROWTHS(DEATH, IGNORE), SNAKE_STEP_GROWTHS(DEATH, DEATH)},
+        {SNAKE_STEP_GROWTHS(WRAP, IGNORE), SNAKE_STEP_GROWTHS(WRAP, DEATH)}};
+
+    if (rules.walls < WALL_RULE::BLOCK || rules.walls >= WALL_RULE::END_ENUM ||
+        rules.neck < NECK_RULE::IGNORE || rules.neck >= NECK_RULE::END_ENUM ||
+        rules.growth == 0 || rules.growth > MAX_GROWTH)
+        throw std::invalid_argument("Simulation::selectStep | Unsupported rule set");
+    return table[static_cast<int>(rules.walls)][static_cast<int>(rules.neck)][rules.growth - 1];
+}
+
+#undef SNAKE_STEP_GROWTHS
+
+const RuleSet &Simulation::getRules() const
+{
+    return pRules;
+}
+
+void Simulation::moveSnake(std::uint32_t tile)
+{
+    std::uint32_t capacity = static_cast<std::uint32_t>(pSnake.size());
+    pHash ^= zobristKey(getTailTile(), ZOBRIST_TAIL);
+
+    // Push the new head, the ring grows towards lower indices
+    pSnakeHead = (pSnakeHead == 0) ? (capacity - 1) : (pSnakeHead - 1);
+    pSnake[pSnakeHead] = tile;
+
+    // Pop the tail, unless the snake is growing
+    if (pGrowth > 0)
+    {
+        pGrowth--;
+        pSnakeLength++;
+    }
+    else
+    {
+        if (pDelta)
+            pDelta->tail = pSnake[(pSnakeHead + pSnakeLength) % capacity];
+        setTile(pSnake[(pSnakeHead + pSnakeLength) % capacity], CELL::EMPTY);
+    }
+
+    // Update the occupancy map, only the tiles at both ends of the snake change
+    if (pSnakeLength > 1)
+        setTile(pSnake[(pSnakeHead + 1) % capacity], CELL::NECK);
+    if (pSnakeLength > 2)
+        setTile(pSnake[(pSnakeHead + 2) % capacity], CELL::BODY);
+    if (pDelta)
+    {
+        pDelta->moved = true;
+        if (pOccupancy[cellIndex(tile)] == CELL::EMPTY)
+            pDelta->headSlot = pTileSlot[tile];
+    }
+    setTile(pSnake[pSnakeHead], CELL::HEAD);
+    pTileSlot[tile] = pSnakeHead;
+    pHash ^= zobristKey(getTailTile(), ZOBRIST_TAIL);
+}
+
+void Simulation::eatFood(std::uint32_t tile)
+{
+    for (auto iter = pFood.begin(); iter != pFood.end(); ++iter)
+    {
+        if (iter->tile == tile)
+        {
+            if (pDelta)
+            {
+                pDelta->eatenIndex = static_cast<std::uint32_t>(iter - pFood.begin());
+                pDelta->eatenKind = iter->kind;
+            }
+            pFood.erase(iter);
+            break;
+        }
+    }
+    // No need to clear the tile, the head is about to take it
+}
+
+void Simulation::setTile(std::uint32_t tile, CELL cell)
+{
+    std::size_t index = cellIndex(tile);
+    if (pOccupancy[index] == CELL::EMPTY && cell != CELL::EMPTY)
+    {
+        // Swap the last free tile into this one's slot
+        std::uint32_t last = pFreeTiles[--pFreeTileCount];
+        pFreeTiles[pTileSlot[tile]] = last;
+        pTileSlot[last] = pTileSlot[tile];
+        pChunkCount[index >> (2 * CHUNK_SHIFT)]++;
+    }
+    else if (pOccupancy[index] != CELL::EMPTY && cell == CELL::EMPTY)
+    {
+        pFreeTiles[pFreeTileCount] = tile;
+        pTileSlot[tile] = pFreeTileCount++;
+        pChunkCount[index >> (2 * CHUNK_SHIFT)]--;
+    }
+    // Empty tiles have no key, XORing one out and the other in covers every change
+    if (pOccupancy[index] != CELL::EMPTY)
+        pHash ^= zobristKey(tile, static_cast<std::uint32_t>(pOccupancy[index]));
+    if (cell != CELL::EMPTY)
+        pHash ^= zobristKey(tile, static_cast<std::uint32_t>(cell));
+    pOccupancy[index] = cell;
+}
+
+void Simulation::releaseTile(std::uint32_t tile, std::uint32_t slot)
+{
+    // The tile that was swapped into its slot goes back to the end. Nothing was swapped
+    // if it was the last one, whatever is left past the end isn't a free tile anymore
+    if (slot < pFreeTileCount)
+    {
+        std::uint32_t last = pFreeTiles[slot];
+        pFreeTiles[pFreeTileCount] = last;
+        pTileSlot[last] = pFreeTileCount;
+    }
+    pFreeTiles[slot] = tile;
+    pTileSlot[tile] = slot;
+    pFreeTileCount++;
+
+    std::size_t index = cellIndex(tile);
+    pChunkCount[index >> (2 * CHUNK_SHIFT)]--;
+    pOccupancy[index] = CELL::EMPTY;
+}
+
+std::uint32_t Simulation::getTailTile() const
+{
+    return pSnake[(pSnakeHead + pSnakeLength - 1) % pSnake.size()];
+}
+
+std::uint64_t Simulation::getHash() const
+{
+    return pHash;
+}
+
+std::uint64_t Simulation::computeHash() const
+{
+    std::uint64_t hash = zobristKey(getTailTile(), ZOBRIST_TAIL);
+    std::uint32_t tiles = static_cast<std::uint32_t>(pSnake.size());
+    for (std::uint32_t tile = 0; tile < tiles; ++tile)
+    {
+        CELL cell = pOccupancy[cellIndex(tile)];
+        if (cell != CELL::EMPTY)
+            hash ^= zobristKey(tile, static_cast<std::uint32_t>(cell));
+    }
+    return hash;
+}
+
+std::size_t Simulation::cellIndex(int x, int y) const
+{
+    std::size_t chunk = (static_cast<std::size_t>(y >> CHUNK_SHIFT) * pChunksX) + (x >> CHUNK_SHIFT);
+    return (chunk << (2 * CHUNK_SHIFT)) | ((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1));
+}
+
+std::size_t Simulation::cellIndex(std::uint32_t tile) const
+{
+    return cellIndex(static_cast<int>(tile % pXTiles), static_cast<int>(tile / pXTiles));
+}
+
+void GameRandom::seed(std::uint32_t value)
+{
+    state[0] = value;
+    for (std::uint32_t i = 1; i < STATE_SIZE; ++i)
+        state[i] = 1812433253u * (state[i - 1] ^ (state[i - 1] >> 30)) + i;
+    index = STATE_SIZE;
+}
+
+std::uint32_t GameRandom::operator()()
+{
+    // Regenerate the whole state every 624 numbers
+    if (index >= STATE_SIZE)
+    {
+        for (std::uint32_t i = 0; i < STATE_SIZE; ++i)
+        {
+            std::uint32_t y = (state[i] & 0x80000000u) | (state[(i + 1) % STATE_SIZE] & 0x7FFFFFFFu);
+            state[i] = state[(i + 397) % STATE_SIZE] ^ (y >> 1) ^ ((y & 1) ? 0x9908B0DFu : 0);
+        }
+        index = 0;
+    }
+
+    // Tempering
+    std::uint32_t y = state[index++];
+    y ^= y >> 11;
+    y ^= (y << 7) & 0x9D2C5680u;
+    y ^= (y << 15) & 0xEFC60000u;
+    y ^= y >> 18;
+    return y;
+}
+
+void GameRandom::untwist(std::uint32_t first)
+{
+    // Every regenerated word is state[i + 397] ^ twist(y), y holding state[i]'s top bit and
+    // state[i + 1]'s low bits from before. twist() keeps y's low bit in its top one so it
+    // can be undone, going down from the end the words needed are always the right version
+    auto mixed = [this](std::uint32_t i) {
+        std::uint32_t value = state[i] ^ state[(i + 397) % STATE_SIZE];
+        if (value & 0x80000000u)
+            return ((value ^ 0x9908B0DFu) << 1) | 1u;
+        return value << 1;
+    };
+    for (std::uint32_t i = STATE_SIZE - 1; i > 0; --i)
+        state[i] = (mixed(i) & 0x80000000u) | (mixed(i - 1) & 0x7FFFFFFFu);
+    state[0] = first;
+    index = STATE_SIZE;
+}
+
+// Rejection sampling keeps the result uniform and identical across standard libraries
+std::uint32_t randomBelow(GameRandom &rng, std::uint32_t range)
+{
+    std::uint32_t limit = 0xFFFFFFFFu - ((0xFFFFFFFFu % range) + 1) % range;
+    std::uint32_t value;
+    do
+        value = rng();
+    while (value > limit);
+    return value % range;
+}
+
+std::uint8_t Simulation::respawnFood(std::uint8_t amount)
+{
+    for (std::uint8_t i = 0; i < amount; ++i)
+    {
+        if (pFreeTileCount == 0)
+            return i;
+
+        // Pick uniformly among the empty tiles
+        FoodItem food;
+        std::uint32_t slot = randomBelow(pMt, pFreeTileCount);
+        food.tile = pFreeTiles[slot];
+        if (pDelta)
+            pDelta->foodSlot = slot;
+        food.kind = static_cast<std::uint8_t>(randomBelow(pMt, FOOD_KINDS));
+        pFood.push_back(food);
+        setTile(food.tile, CELL::FOOD);
+    }
+    return amount;
+}
+
+void Simulation::saveState(std::vector<std::uint8_t> &out) const
+{
+    putBytes(out, STATE_VERSION, 1);
+    putBytes(out, pXTiles, 2);
+    putBytes(out, pYTiles, 2);
+    putBytes(out, pSeed, 4);
+    putBytes(out, pColorSeed, 4);
+    putBytes(out, pAlive ? 1 : 0, 1);
+    putBytes(out, pGrowth, 4);
+
+    // The occupancy map is rebuilt from the snake and the food, the free tile
+    // order is kept as is since it decides where the next food lands
+    putBytes(out, pSnakeLength, 4);
+    for (std::uint32_t i = 0; i < pSnakeLength; ++i)
+        putBytes(out, getSegment(i), 4);
+    putBytes(out, pFreeTileCount, 4);
+    for (std::uint32_t i = 0; i < pFreeTileCount; ++i)
+        putBytes(out, pFreeTiles[i], 4);
+    putBytes(out, static_cast<std::uint32_t>(pFood.size()), 4);
+    for (const FoodItem &food : pFood)
+    {
+        putBytes(out, food.tile, 4);
+        putBytes(out, food.kind, 1);
+    }
+
+    for (std::uint32_t i = 0; i < GameRandom::STATE_SIZE; ++i)
+        putBytes(out, pMt.state[i], 4);
+    putBytes(out, pMt.index, 2);
+}
+
+bool Simulation::loadState(const std::uint8_t *data, std::size_t size)
+{
+    const std::uint8_t *end = data + size;
+    std::uint32_t version, xTiles, yTiles, seed, colorSeed, alive, growth, length, freeCount, foodCount;
+    if (!getBytes(data, end, version, 1) || version != STATE_VERSION ||
+        !getBytes(data, end, xTiles, 2) || !getBytes(data, end, yTiles, 2) ||
+        xTiles != pXTiles || yTiles != pYTiles ||
+        !getBytes(data, end, seed, 4) || !getBytes(data, end, colorSeed, 4) ||
+        !getBytes(data, end, alive, 1) || !getBytes(data, end, growth, 4) ||
+        !getBytes(data, end, length, 4))
+        return false;
+
+    std::uint32_t tiles = pSnake.size();
+    std::vector<std::uint32_t> segments, freeTiles;
+    std::vector<FoodItem> food;
+    if (length == 0 || length > tiles)
+        return false;
+    for (std::uint32_t i = 0, value; i < length; ++i)
+    {
+        if (!getBytes(data, end, value, 4) || value >= tiles)
+            return false;
+        segments.push_back(value);
+    }
+    if (!getBytes(data, end, freeCount, 4) || freeCount > tiles)
+        return false;
+    for (std::uint32_t i = 0, value; i < freeCount; ++i)
+    {
+        if (!getBytes(data, end, value, 4) || value >= tiles)
+            return false;
+        freeTiles.push_back(value);
+    }
+    if (!getBytes(data, end, foodCount, 4))
+        return false;
+    for (std::uint32_t i = 0, tile, kind; i < foodCount; ++i)
+    {
+        if (!getBytes(data, end, tile, 4) || !getBytes(data, end, kind, 1) || tile >= tiles || kind >= FOOD_KINDS)
+            return false;
+        FoodItem item;
+        item.tile = tile;
+        item.kind = kind;
+        food.push_back(item);
+    }
+    GameRandom mt;
+    for (std::uint32_t i = 0; i < GameRandom::STATE_SIZE; ++i)
+        if (!getBytes(data, end, mt.state[i], 4))
+            return false;
+    if (!getBytes(data, end, mt.index, 2) || mt.index > GameRandom::STATE_SIZE)
+        return false;
+
+    // Everything checks out, replace the current state
+    pSeed = seed;
+    pColorSeed = colorSeed;
+    pAlive = (alive != 0);
+    pGrowth = growth;
+    pMt = mt;
+    pSnakeHead = 0;
+    pSnakeLength = length;
+    std::copy(segments.begin(), segments.end(), pSnake.begin());
+    pFood = food;
+
+    std::fill(pOccupancy.begin(), pOccupancy.end(), CELL::EMPTY);
+    std::fill(pChunkCount.begin(), pChunkCount.end(), 0);
+    for (const FoodItem &item : pFood)
+    {
+        pOccupancy[cellIndex(item.tile)] = CELL::FOOD;
+        pChunkCount[cellIndex(item.tile) >> (2 * CHUNK_SHIFT)]++;
+    }
+    for (std::uint32_t i = 0; i < pSnakeLength; ++i)
+    {
+        pOccupancy[cellIndex(pSnake[i])] = (i == 0) ? CELL::HEAD : ((i == 1) ? CELL::NECK : CELL::BODY);
+        pChunkCount[cellIndex(pSnake[i]) >> (2 * CHUNK_SHIFT)]++;
+        pTileSlot[pSnake[i]] = i;
+    }
+    pFreeTileCount = freeCount;
+    for (std::uint32_t i = 0; i < pFreeTileCount; ++i)
+    {
+        pFreeTiles[i] = freeTiles[i];
+        pTileSlot[freeTiles[i]] = i;
+    }
+    pHash = computeHash();
+    return true;
+}
+
+std::size_t Simulation::getSnapshotSize() const
+{
+    return SnapshotLayout(pSnake.size(), pChunkCount.size(), pFood.size()).size;
+}
+
+void Simulation::writeSnapshot(void *buffer) const
+{
+    std::size_t tiles = pSnake.size();
+    SnapshotLayout layout(tiles, pChunkCount.size(), pFood.size());
+    std::uint8_t *out = static_cast<std::uint8_t *>(buffer);
+
+    SimulationSnapshot header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.size = static_cast<std::uint32_t>(layout.size);
+    header.xTiles = pXTiles;
+    header.yTiles = pYTiles;
+    header.seed = pSeed;
+    header.colorSeed = pColorSeed;
+    header.snakeHead = pSnakeHead;
+    header.snakeLength = pSnakeLength;
+    header.growth = pGrowth;
+    header.freeTileCount = pFreeTileCount;
+    header.foodCount = static_cast<std::uint32_t>(pFood.size());
+    header.alive = pAlive ? 1 : 0;
+    header.hash = pHash;
+    header.rng = pMt;
+    std::memcpy(out, &header, sizeof(header));
+
+    std::memcpy(out + layout.snake, pSnake.data(), tiles * sizeof(std::uint32_t));
+    std::memcpy(out + layout.freeTiles, pFreeTiles.data(), tiles * sizeof(std::uint32_t));
+    std::memcpy(out + layout.tileSlot, pTileSlot.data(), tiles * sizeof(std::uint32_t));
+    std::memcpy(out + layout.occupancy, pOccupancy.data(), pOccupancy.size() * sizeof(CELL));
+    std::memcpy(out + layout.chunkCount, pChunkCount.data(), pChunkCount.size() * sizeof(std::uint16_t));
+    if (!pFood.empty())
+        std::memcpy(out + layout.food, pFood.data(), pFood.size() * sizeof(FoodItem));
+}
+
+bool Simulation::checkSnapshotHeader(const void *buffer, std::size_t size) const
+{
+    if (size < sizeof(SimulationSnapshot))
+        return false;
+    const SimulationSnapshot *header = static_cast<const SimulationSnapshot *>(buffer);
+    std::size_t tiles = pSnake.size();
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != SNAPSHOT_VERSION || header->xTiles != pXTiles || header->yTiles != pYTiles ||
+        header->foodCount > tiles)
+        return false;
+
+    SnapshotLayout layout(tiles, pChunkCount.size(), header->foodCount);
+    return header->size == layout.size && size >= layout.size &&
+        header->snakeHead < tiles && header->snakeLength != 0 && header->snakeLength <= tiles &&
+        header->freeTileCount <= tiles && header->rng.index <= GameRandom::STATE_SIZE;
+}
+
+bool Simulation::verifySnapshot(const void *buffer, std::size_t size) const
+{
+    if (!checkSnapshotHeader(buffer, size))
+        return false;
+    const SimulationSnapshot *header = static_cast<const SimulationSnapshot *>(buffer);
+    const std::uint8_t *in = static_cast<const std::uint8_t *>(buffer);
+    std::uint32_t tiles = static_cast<std::uint32_t>(pSnake.size());
+    SnapshotLayout layout(tiles, pChunkCount.size(), header->foodCount);
+    const std::uint32_t *snake = reinterpret_cast<const std::uint32_t *>(in + layout.snake);
+    const std::uint32_t *freeTiles = reinterpret_cast<const std::uint32_t *>(in + layout.freeTiles);
+    const std::uint32_t *tileSlot = reinterpret_cast<const std::uint32_t *>(in + layout.tileSlot);
+    const CELL *occupancy = reinterpret_cast<const CELL *>(in + layout.occupancy);
+    const std::uint16_t *chunkCount = reinterpret_cast<const std::uint16_t *>(in + layout.chunkCount);
+    const FoodItem *food = reinterpret_cast<const FoodItem *>(in + layout.food);
+
+    if (header->snakeLength + header->foodCount > tiles ||
+        header->freeTileCount != tiles - header->snakeLength - header->foodCount)
+        return false;
+
+    // Rebuild the board from the body and the food, every tile used once at most
+    std::vector<CELL> board(tiles, CELL::EMPTY);
+    for (std::uint32_t i = 0; i < header->snakeLength; ++i)
+    {
+        std::uint32_t slot = (header->snakeHead + i) % tiles, tile = snake[slot];
+        if (tile >= tiles || board[tile] != CELL::EMPTY || tileSlot[tile] != slot)
+            return false;
+        board[tile] = (i == 0) ? CELL::HEAD : ((i == 1) ? CELL::NECK : CELL::BODY);
+    }
+    for (std::uint32_t i = 0; i < header->foodCount; ++i)
+    {
+        if (food[i].tile >= tiles || food[i].kind >= FOOD_KINDS || board[food[i].tile] != CELL::EMPTY)
+            return false;
+        board[food[i].tile] = CELL::FOOD;
+    }
+    // The free list has to hold exactly the empty tiles, each pointing back at its slot
+    for (std::uint32_t slot = 0; slot < header->freeTileCount; ++slot)
+    {
+        std::uint32_t tile = freeTiles[slot];
+        if (tile >= tiles || board[tile] != CELL::EMPTY || tileSlot[tile] != slot)
+            return false;
+    }
+
+    // The stored map and counts must match it, and so must the hash
+    std::vector<std::uint16_t> counts(pChunkCount.size(), 0);
+    std::uint64_t hash = zobristKey(snake[(header->snakeHead + header->snakeLength - 1) % tiles], ZOBRIST_TAIL);
+    for (std::uint32_t tile = 0; tile < tiles; ++tile)
+    {
+        std::size_t index = cellIndex(tile);
+        if (occupancy[index] != board[tile])
+            return false;
+        if (board[tile] != CELL::EMPTY)
+        {
+            counts[index >> (2 * CHUNK_SHIFT)]++;
+            hash ^= zobristKey(tile, static_cast<std::uint32_t>(board[tile]));
+        }
+    }
+    return std::equal(counts.begin(), counts.end(), chunkCount) && hash == header->hash;
+}
+
+bool Simulation::readSnapshot(const void *buffer, std::size_t size)
+{
+    if (!checkSnapshotHeader(buffer, size))
+        return false;
+    const SimulationSnapshot *header = static_cast<const SimulationSnapshot *>(buffer);
+    const std::uint8_t *in = static_cast<const std::uint8_t *>(buffer);
+    std::size_t tiles = pSnake.size();
+    SnapshotLayout layout(tiles, pChunkCount.size(), header->foodCount);
+
+    pSeed = header->seed;
+    pColorSeed = header->colorSeed;
+    pSnakeHead = header->snakeHead;
+    pSnakeLength = header->snakeLength;
+    pGrowth = header->growth;
+    pFreeTileCount = header->freeTileCount;
+    pAlive = (header->alive != 0);
+    pMt = header->rng;
+
+    std::memcpy(pSnake.data(), in + layout.snake, tiles * sizeof(std::uint32_t));
+    std::memcpy(pFreeTiles.data(), in + layout.freeTiles, tiles * sizeof(std::uint32_t));
+    std::memcpy(pTileSlot.data(), in + layout.tileSlot, tiles * sizeof(std::uint32_t));
+    std::memcpy(pOccupancy.data(), in + layout.occupancy, pOccupancy.size() * sizeof(CELL));
+    std::memcpy(pChunkCount.data(), in + layout.chunkCount, pChunkCount.size() * sizeof(std::uint16_t));
+    pFood.resize(header->foodCount);
+    if (!pFood.empty())
+        std::memcpy(pFood.data(), in + layout.food, pFood.size() * sizeof(FoodItem));
+    pHash = header->hash;
+    return true;
+}
+
+std::uint32_t Simulation::getScore() const
+{
+    return pSnakeLength - 1;
+}
+
+std::uint32_t Simulation::getSeed() const
+{
+    return pSeed;
+}
+
+std::uint32_t Simulation::getColorSeed() const
+{
+    return pColorSeed;
+}
+
+bool Simulation::isAlive() const
+{
+    return pAlive;
+}
+
+std::uint16_t Simulation::getXTiles() const
+{
+    return pXTiles;
+}
+
+std::uint16_t Simulation::getYTiles() const
+{
+    return pYTiles;
+}
+
+std::uint32_t Simulation::getLength() const
+{
+    return pSnakeLength;
+}
+
+std::uint32_t Simulation::getSegment(std::uint32_t segment) const
+{
+    return pSnake[(pSnakeHead + segment) % pSnake.size()];
+}
+
+std::uint32_t Simulation::getSegmentAt(std::uint32_t tile) const
+{
+    std::uint32_t capacity = static_cast<std::uint32_t>(pSnake.size());
+    return (pTileSlot[tile] + capacity - pSnakeHead) % capacity;
+}
+
+vec2d Simulation::getHeadTile() const
+{
+    vec2d tile;
+    tile.x = pSnake[pSnakeHead] % pXTiles;
+    tile.y = pSnake[pSnakeHead] / pXTiles;
+    return tile;
+}
+
+CELL Simulation::getCell(std::uint32_t tile) const
+{
+    return pOccupancy[cellIndex(tile)];
+}
+
+CELL Simulation::getCell(int x, int y) const
+{
+    return pOccupancy[cellIndex(x, y)];
+}
+
+const std::vector<FoodItem> &Simulation::getFood() const
+{
+    return pFood;
+}
+
+std::uint16_t Simulation::getChunksX() const
+{
+    return pChunksX;
+}
+
+std::uint16_t Simulation::getChunksY() const
+{
+    return pChunksY;
+}
+
+std::uint16_t Simulation::getChunkCount(int chunkX, int chunkY) const
+{
+    return pChunkCount[(static_cast<std::size_t>(chunkY) * pChunksX) + chunkX];
+}
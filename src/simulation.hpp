@@ -0,0 +1,236 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// The game rules, free of any SDL / OpenGL dependency so they can run without a window.
+// Everything is expressed in tiles, Grid wraps a Simulation and takes care of the pixels.
+
+enum class DIRECTION : std::int8_t {UP = 0, DOWN = 1, LEFT = 2, RIGHT = 3, NO_DIRECTION = 4, END_ENUM = 5};
+enum class COLLISION : std::int8_t {NO_COLLISION = 0, WALL = 1, SNAKE = 2, FOOD = 3, NECK = 4, END_ENUM = 5};
+// Per tile occupancy tags, stored one byte per tile in Simulation::pOccupancy
+enum class CELL : std::uint8_t {EMPTY = 0, HEAD = 1, NECK = 2, BODY = 3, FOOD = 4, END_ENUM = 5};
+
+// Rule variants, the defaults are the original game's
+enum class WALL_RULE : std::int8_t {BLOCK = 0, DEATH = 1, WRAP = 2, END_ENUM = 3};
+enum class NECK_RULE : std::int8_t {IGNORE = 0, DEATH = 1, END_ENUM = 2};
+
+struct RuleSet
+{
+    WALL_RULE walls;     // What running into the board's edge does
+    NECK_RULE neck;      // What turning back into the neck does
+    std::uint8_t growth; // Segments gained per piece of food, 1 to Simulation::MAX_GROWTH
+
+    RuleSet() : walls(WALL_RULE::BLOCK), neck(NECK_RULE::IGNORE), growth(1) {}
+};
+
+struct vec2d
+{
+    int x, y;
+};
+
+// A piece of food on the board, the kind only decides which sprite gets drawn
+struct FoodItem
+{
+    std::uint32_t tile;
+    std::uint8_t kind;
+};
+
+// Mersenne twister, same sequence as std::mt19937 but plain data, so the generator
+// can be copied along with the rest of the game state
+struct GameRandom
+{
+    static const std::uint32_t STATE_SIZE = 624;
+    std::uint32_t state[STATE_SIZE];
+    std::uint32_t index;
+
+    void seed(std::uint32_t value);
+    std::uint32_t operator()();
+    // Reverses the last regeneration, first is state[0] from before it. It's the one
+    // word the regeneration can't be run backwards for
+    void untwist(std::uint32_t first);
+};
+
+// Uniform random number in [0, range), identical across standard libraries
+std::uint32_t randomBelow(GameRandom &rng, std::uint32_t range);
+
+// Snapshot of a whole Simulation, plain data in native byte order so it can be
+// written to or mapped from a file and used as is. The header is followed by
+// these arrays, in this order:
+//   std::uint32_t snake[tiles], freeTiles[tiles], tileSlot[tiles]
+//   CELL occupancy[chunks * 256]
+//   std::uint16_t chunkCount[chunks] (padded to 4 bytes)
+//   FoodItem food[foodCount]
+struct SimulationSnapshot
+{
+    char magic[4]; // "SNKS"
+    std::uint32_t version, size; // Size counts the header and the arrays
+    std::uint16_t xTiles, yTiles;
+    std::uint32_t seed, colorSeed;
+    std::uint32_t snakeHead, snakeLength, growth, freeTileCount, foodCount;
+    std::uint8_t alive, padding[3];
+    std::uint64_t hash; // Saves recomputing it on every read, see Simulation::getHash()
+    GameRandom rng;
+};
+
+// What one tick changed, enough for Simulation::undo() to put the game back exactly
+// as it was. A few bytes whatever the board's size, see RewindBuffer
+struct TickDelta
+{
+    std::uint64_t hash;
+    std::uint32_t tail;       // Tile the tail left, NO_TILE if the snake grew or didn't move
+    std::uint32_t headSlot;   // Free list slot the head's new tile was taken from, NO_TILE if it wasn't empty
+    std::uint32_t foodSlot;   // Free list slot of the food placed this tick, NO_TILE if none
+    std::uint32_t eatenIndex; // Position of the eaten food in the food list, NO_TILE if none
+    std::uint32_t growth, length;
+    std::uint32_t rngFirst;   // The generator's state[0], see GameRandom::untwist()
+    std::uint16_t rngIndex;
+    std::uint8_t eatenKind;
+    DIRECTION dir;
+    bool alive, moved;
+};
+
+class Simulation
+{
+private:
+    std::uint16_t pXTiles, pYTiles;
+    std::uint16_t pChunksX, pChunksY; // Board size in chunks, rounded up
+
+    // Player, the body is a fixed capacity ring buffer of tile indices (head first)
+    // sized to the whole board
+    std::vector<std::uint32_t> pSnake;
+    std::uint32_t pSnakeHead, pSnakeLength; // Ring position of the head, total segments (head included)
+    std::uint32_t pGrowth; // Segments to add on the upcoming moves
+    bool pAlive;
+
+    // Occupancy map, one tag per tile kept in sync by moveSnake() and respawnFood() so
+    // collision tests are a single lookup. Stored chunk by chunk (CHUNK_SIZE tiles square,
+    // row major inside and across chunks) so a chunk is one contiguous block, with a
+    // count of the occupied tiles in each one so empty chunks can be skipped entirely
+    std::vector<CELL> pOccupancy;
+    std::vector<std::uint16_t> pChunkCount;
+    // Every empty tile, densely packed so food can be placed with a single random pick.
+    // pTileSlot maps an empty tile to its position in pFreeTiles (swap and pop removal)
+    // and a snake tile to its position in pSnake
+    std::vector<std::uint32_t> pFreeTiles, pTileSlot;
+    std::uint32_t pFreeTileCount;
+    std::vector<FoodItem> pFood;
+
+    // Random number generator, reseeded every game. The color seed is drawn from it
+    // so a seed reproduces the whole game, looks included
+    GameRandom pMt;
+    std::uint32_t pSeed, pColorSeed;
+
+    // Zobrist hash of the board, every occupied tile's tag plus the tail's position. The
+    // neck has its own tag so the head's heading is in there too. Updated by setTile()
+    // and moveSnake() as the tiles change, never recomputed while playing
+    std::uint64_t pHash;
+
+    // step() for every rule variant, instantiated ahead of time so the rules are constants
+    // inside and the branches on them fold away. pStep is picked from them once
+    typedef COLLISION (Simulation::*StepFunction)(DIRECTION dir);
+    template <WALL_RULE Walls, NECK_RULE Neck, std::uint8_t Growth>
+    COLLISION stepRules(DIRECTION dir);
+    static StepFunction selectStep(const RuleSet &rules);
+    RuleSet pRules;
+    StepFunction pStep;
+    // Filled in by the tick being played, only while step(dir, delta) runs
+    TickDelta *pDelta;
+
+    void moveSnake(std::uint32_t tile);
+    void eatFood(std::uint32_t tile);
+    // Tags a tile and keeps the free tile list and chunk counts in sync
+    void setTile(std::uint32_t tile, CELL cell);
+    // Undoes setTile() taking an empty tile, slot is where it was in the free list
+    void releaseTile(std::uint32_t tile, std::uint32_t slot);
+    std::size_t cellIndex(int x, int y) const;
+    std::size_t cellIndex(std::uint32_t tile) const;
+    std::uint32_t getTailTile() const;
+    bool checkSnapshotHeader(const void *buffer, std::size_t size) const;
+
+public:
+    static const std::uint8_t FOOD_KINDS = 6;
+    static const std::uint8_t STARTING_FOOD = 14;
+    static const std::uint16_t MAX_SIDE = 4096;
+    static const std::uint8_t CHUNK_SHIFT = 4;
+    static const std::uint16_t CHUNK_SIZE = 1 << CHUNK_SHIFT;
+    static const std::uint8_t MAX_GROWTH = 4;
+    static const std::uint32_t NO_TILE = 0xFFFFFFFF;
+
+    // Both sides must be between 1 and MAX_SIDE tiles, throws std::invalid_argument
+    // otherwise or on an unsupported rule set
+    Simulation(std::uint16_t xTiles, std::uint16_t yTiles, const RuleSet &rules = RuleSet());
+
+    void reset(std::uint32_t seed);
+    // Advances the game by one move. By default walls stop the snake and running into the
+    // neck is ignored, see RuleSet. Hitting the rest of the body always ends the game
+    COLLISION step(DIRECTION dir);
+    // Same as step(), also writes down what the tick changed so undo() can take it back
+    COLLISION step(DIRECTION dir, TickDelta &delta);
+    // Takes back a recorded tick, newest first. Any other change in between (reset(),
+    // loadState(), an unrecorded step) invalidates the older deltas
+    void undo(const TickDelta &delta);
+    const RuleSet &getRules() const;
+    // Returns how many pieces were placed, fewer than asked only when the board is full
+    std::uint8_t respawnFood(std::uint8_t amount);
+
+    // Appends the whole game state to out, loading it back resumes the game exactly where it was
+    void saveState(std::vector<std::uint8_t> &out) const;
+    // Returns false if the data is malformed or was saved from a different board size
+    bool loadState(const std::uint8_t *data, std::size_t size);
+
+    // Raw snapshots, a handful of memcpy calls each way. saveState() is the portable
+    // format, snapshots are meant for the same build on the same machine
+    std::size_t getSnapshotSize() const;
+    // buffer must hold getSnapshotSize() bytes and be suitably aligned (any malloc / mmap result is)
+    void writeSnapshot(void *buffer) const;
+    // Returns false if the header doesn't match this build or board size. Only the header
+    // is checked, the arrays are trusted: fine for snapshots this process wrote itself
+    bool readSnapshot(const void *buffer, std::size_t size);
+    // Checks a whole snapshot against the header: every tile index in range, body, food
+    // and free list consistent with each other, occupancy, chunk counts and hash matching.
+    // Run it before readSnapshot() on anything that came from outside, like a file
+    bool verifySnapshot(const void *buffer, std::size_t size) const;
+
+    // 64 bit hash of the head, body, food and heading, equal boards hash the same. The
+    // generator's state isn't included, the food still to come can differ
+    std::uint64_t getHash() const;
+    // Same hash computed from scratch, for checking the incremental one
+    std::uint64_t computeHash() const;
+
+    std::uint32_t getScore() const;
+    std::uint32_t getSeed() const;
+    std::uint32_t getColorSeed() const;
+    bool isAlive() const;
+
+    std::uint16_t getXTiles() const;
+    std::uint16_t getYTiles() const;
+    std::uint32_t getLength() const;
+    // Tile index of a body segment, segment 0 is the head
+    std::uint32_t getSegment(std::uint32_t segment) const;
+    // Segment number of a tile the snake is on
+    std::uint32_t getSegmentAt(std::uint32_t tile) const;
+    vec2d getHeadTile() const;
+    CELL getCell(std::uint32_t tile) const;
+    CELL getCell(int x, int y) const;
+    const std::vector<FoodItem> &getFood() const;
+
+    std::uint16_t getChunksX() const;
+    std::uint16_t getChunksY() const;
+    // Occupied tiles (snake and food) in a chunk
+    std::uint16_t getChunkCount(int chunkX, int chunkY) const;
+};
+
+#endif
@@ -129,12 +129,12 @@ void SGL_Camera::cameraMode(SGL_Shader shader, CAMERA_MODE mode) noexcept
     if (mode == DEFAULT)
     {
         // Camera is active, apply the offset to the projection matrix
-        shader.use(*WMOGLM).setMatrix4(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_M4F_PROJECTION.c_str(), pCameraMatrix);
+        shader.use(*WMOGLM).setMatrix4(*WMOGLM, SHADER_UNIFORM::PROJECTION, pCameraMatrix);
     }
     else if (mode == OVERLAY)
     {
         // Camera is disabled, apply the original overlay  matrix
-        shader.use(*WMOGLM).setMatrix4(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_M4F_PROJECTION.c_str(), pOverlayMatrix);
+        shader.use(*WMOGLM).setMatrix4(*WMOGLM, SHADER_UNIFORM::PROJECTION, pOverlayMatrix);
     }
 
 }
@@ -181,3 +181,34 @@ glm::vec4 SGL_Camera::getPosition() const noexcept
 {
     return glm::vec4(this->pCameraPos.x, this->pCameraPos.y, pScreenW, pScreenH);
 }
+
+
+/**
+ * @brief Maps a screen point to world coordinates, the inverse of the camera matrix.
+ * The matrix scales around the screen's center after centering the camera position
+ * on it, so screen = center + scale * (world - position)
+ *
+ * @param screen Point in internal resolution pixels
+ * @return glm::vec2 The world position under that point
+ */
+glm::vec2 SGL_Camera::screenToWorld(glm::vec2 screen) const noexcept
+{
+    // The scale matrix flattens Z, so it can't be inverted as a whole
+    float scale = (std::abs(pScale) < 0.001f) ? 0.001f : pScale;
+    glm::vec2 center(static_cast<float>(pScreenW / 2), static_cast<float>(pScreenH / 2));
+    return pCameraPos + ((screen - center) / scale);
+}
+
+
+/**
+ * @brief Returns the world area currently in view, useful to cull anything outside of it
+ *
+ * @return glm::vec4 The visible area (x, y, w, h)
+ */
+glm::vec4 SGL_Camera::getViewport() const noexcept
+{
+    glm::vec2 corner = screenToWorld(glm::vec2(0.0f, 0.0f));
+    glm::vec2 opposite = screenToWorld(glm::vec2(static_cast<float>(pScreenW), static_cast<float>(pScreenH)));
+    glm::vec2 topLeft = glm::min(corner, opposite), bottomRight = glm::max(corner, opposite);
+    return glm::vec4(topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y);
+}
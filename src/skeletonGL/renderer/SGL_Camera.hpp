@@ -26,6 +26,7 @@
 
 // C++
 #include <memory>
+#include <cmath>
 // Dependencies
 #include "../deps/glm/glm.hpp"
 #include "../utility/SGL_DataStructures.hpp"
@@ -72,6 +73,10 @@ public:
     glm::mat4 getOverlayMatrix() const noexcept;
     // Returns the camera position
     glm::vec4 getPosition() const noexcept;
+    // Maps a point in internal resolution pixels to world coordinates (inverse camera transform)
+    glm::vec2 screenToWorld(glm::vec2 screen) const noexcept;
+    // Returns the visible world area (x, y, w, h)
+    glm::vec4 getViewport() const noexcept;
 };
 
 #endif // SRC_SKELETONGL_RENDERER_CAMERA_HPP
@@ -33,8 +33,8 @@
  */
 SGL_OpenGLManager::SGL_OpenGLManager()
 {
-    currentTextureID = 0;
-    currentShaderID = 0;
+    // A fresh context starts out with OpenGL's defaults
+    setDefaultStateCache();
     initialErrorCap = 0;
 }
 
@@ -53,6 +53,8 @@ SGL_OpenGLManager::~SGL_OpenGLManager()
         deleteVAO(iter.second.name);
     for (auto &iter : FBO)
         deleteFBO(iter.second.name);
+    while (!UBO.empty())
+        deleteUBO(UBO.begin()->first);
 
     VBO.clear();
     VAO.clear();
@@ -60,6 +62,99 @@ SGL_OpenGLManager::~SGL_OpenGLManager()
     FBO.clear();
 }
 
+/**
+ * @brief Updates the issued / elided counters
+ *
+ * @param changed Whether the call would modify the current state
+ * @return bool True if the call must reach OpenGL
+ */
+bool SGL_OpenGLManager::trackState(bool changed) noexcept
+{
+    if (changed)
+        stateCounters.issued++;
+    else
+        stateCounters.elided++;
+    return changed;
+}
+
+/**
+ * @brief Sets the shadow state to what a new OpenGL context starts with, no GL calls are made
+ *
+ * @return nothing
+ */
+void SGL_OpenGLManager::setDefaultStateCache() noexcept
+{
+    currentShaderID = 0;
+    currentTextureID = GL_TEXTURE0;
+    for (std::uint32_t i = 0; i < SGL_OGL_CONSTANTS::MAX_TEXTURE_UNITS; ++i)
+        currentTextures[i] = 0;
+
+    currentGLBuffers.currentVBO.name = "NO_VBO";
+    currentGLBuffers.currentVBO.ID = 0;
+    currentGLBuffers.currentVAO.name = "NO_VAO";
+    currentGLBuffers.currentVAO.ID = 0;
+
+    currentGLSettings.blending.active = false;
+    currentGLSettings.faceCulling.active = false;
+    currentBlendSrc = GL_ONE;
+    currentBlendDst = GL_ZERO;
+    currentLineWidth = 1.0f;
+    currentPointSize = 1.0f;
+    for (std::uint32_t i = 0; i < SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS; ++i)
+    {
+        currentUniformBuffers[i] = 0;
+        currentUniformOffsets[i] = 0;
+    }
+}
+
+/**
+ * @brief Forces OpenGL back to its default state and syncs the cache with it, use it
+ * if the context was modified behind the manager's back
+ *
+ * @return nothing
+ */
+void SGL_OpenGLManager::resetStateCache() noexcept
+{
+    glUseProgram(0);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    for (std::uint32_t i = 0; i < SGL_OGL_CONSTANTS::MAX_TEXTURE_UNITS; ++i)
+    {
+        glActiveTexture(GL_TEXTURE0 + i);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glActiveTexture(GL_TEXTURE0);
+    glDisable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ZERO);
+    glDisable(GL_CULL_FACE);
+    glLineWidth(1.0f);
+    glPointSize(1.0f);
+    for (std::uint32_t i = 0; i < SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS; ++i)
+        glBindBufferBase(GL_UNIFORM_BUFFER, i, 0);
+
+    setDefaultStateCache();
+}
+
+/**
+ * @brief Returns how many state changes were sent to OpenGL and how many were dropped
+ *
+ * @return GLStateCounters Counters since the last resetStateCounters() call
+ */
+const GLStateCounters &SGL_OpenGLManager::getStateCounters() const noexcept
+{
+    return stateCounters;
+}
+
+/**
+ * @brief Zeroes the issued / elided counters
+ *
+ * @return nothing
+ */
+void SGL_OpenGLManager::resetStateCounters() noexcept
+{
+    stateCounters = GLStateCounters();
+}
+
 /**
  * @brief Creates a VBO and adds it to the VBOs storage map
  *
@@ -180,6 +275,35 @@ void SGL_OpenGLManager::createFBO(const std::string &name) noexcept
 
 
 
+/**
+ * @brief Creates a UBO and adds it to the UBOs storage map
+ *
+ * @param name The UBO identifier
+ * @return nothing
+ */
+void SGL_OpenGLManager::createUBO(const std::string &name) noexcept
+{
+    if (UBO.count(name) > 0 )
+    {
+#ifdef SGL_OUTPUT_OPENGL_DETAILS
+        SGL_Log("UBO already exists: " + name, LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_CYAN);
+#endif
+    }
+    else
+    {
+        GLuint newUBO;
+        glGenBuffers(1, &newUBO);
+        GLBuffer storeBuffer;
+        storeBuffer.name = name;
+        storeBuffer.ID = newUBO;
+        UBO[name] = storeBuffer;
+#ifdef SGL_OUTPUT_OPENGL_DETAILS
+        SGL_Log("Created UBO [ "+name+" ] with ID: " + std::to_string(UBO[name].ID), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_CYAN);
+#endif
+    }
+}
+
+
 /**
  * @brief Binds a VBO
  *
@@ -196,7 +320,11 @@ void SGL_OpenGLManager::bindVBO(const std::string &name) noexcept
     }
     else
     {
-        currentGLBuffers.currentVBO = VBO.at(name);
+        const GLBuffer &buffer = VBO.at(name);
+        // GL_ARRAY_BUFFER isn't part of the VAO state, the cached binding survives VAO changes
+        if (!trackState(buffer.ID != currentGLBuffers.currentVBO.ID))
+            return;
+        currentGLBuffers.currentVBO = buffer;
         //update currently bound VBO
         GLuint bufferToBind = SGL_OpenGLManager::currentGLBuffers.currentVBO.ID;
         glBindBuffer(GL_ARRAY_BUFFER, bufferToBind);
@@ -244,7 +372,10 @@ void SGL_OpenGLManager::bindVAO(const std::string &name) noexcept
     }
     else
     {
-        currentGLBuffers.currentVAO = VAO.at(name);
+        const GLBuffer &buffer = VAO.at(name);
+        if (!trackState(buffer.ID != currentGLBuffers.currentVAO.ID))
+            return;
+        currentGLBuffers.currentVAO = buffer;
         //update currently bound VBO
         GLuint bufferToBind = SGL_OpenGLManager::currentGLBuffers.currentVAO.ID;
         glBindVertexArray(bufferToBind);
@@ -288,6 +419,57 @@ void SGL_OpenGLManager::bindFBO(const std::string &name, GLCONSTANTS::FBO type)
     }
 }
 
+/**
+ * @brief Binds a UBO to GL_UNIFORM_BUFFER, to fill it
+ *
+ * @param name The UBO identifier
+ * @return nothing
+ */
+void SGL_OpenGLManager::bindUBO(const std::string &name) noexcept
+{
+    if (UBO.find(name) == UBO.end())
+    {
+#ifdef SGL_OUTPUT_OPENGL_DETAILS
+        SGL_Log("ERROR: UBO NOT FOUND: " + name, LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_CYAN);
+#endif
+    }
+    else
+        glBindBuffer(GL_UNIFORM_BUFFER, UBO.at(name).ID);
+}
+
+/**
+ * @brief Binds a range of a UBO to a uniform block binding point, skipped if it's already there
+ *
+ * @param name The UBO identifier
+ * @param binding Binding point the shaders' uniform block is assigned to
+ * @param offset Start of the range, must be a multiple of GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+ * @param size Size of the range in bytes
+ * @return nothing
+ */
+void SGL_OpenGLManager::bindUBORange(const std::string &name, GLuint binding, GLintptr offset, GLsizeiptr size) noexcept
+{
+    if (UBO.find(name) == UBO.end())
+    {
+#ifdef SGL_OUTPUT_OPENGL_DETAILS
+        SGL_Log("ERROR: UBO NOT FOUND: " + name, LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_CYAN);
+#endif
+        return;
+    }
+
+    GLuint buffer = UBO.at(name).ID;
+    if (binding < SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS)
+    {
+        if (!trackState(currentUniformBuffers[binding] != buffer || currentUniformOffsets[binding] != offset))
+            return;
+        currentUniformBuffers[binding] = buffer;
+        currentUniformOffsets[binding] = offset;
+    }
+    else
+        trackState(true);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, offset, size);
+}
+
 /**
  * @brief Generates a texture
  *
@@ -302,14 +484,24 @@ void SGL_OpenGLManager::genTextures(GLsizei n, GLuint *textures) const noexcept
 
 
 /**
- * @brief Binds a texture
+ * @brief Binds a texture to the active unit, only GL_TEXTURE_2D bindings are cached
  *
  * @param target Texture target
  * @param textures Texture ID
  * @return nothing
  */
-void SGL_OpenGLManager::bindTexture(GLenum target, GLuint texture) const noexcept
+void SGL_OpenGLManager::bindTexture(GLenum target, GLuint texture) noexcept
 {
+    GLuint unit = currentTextureID - GL_TEXTURE0;
+    if (target == GL_TEXTURE_2D && unit < SGL_OGL_CONSTANTS::MAX_TEXTURE_UNITS)
+    {
+        if (!trackState(currentTextures[unit] != texture))
+            return;
+        currentTextures[unit] = texture;
+    }
+    else
+        trackState(true);
+
     glBindTexture(target, texture);
 }
 
@@ -320,8 +512,14 @@ void SGL_OpenGLManager::bindTexture(GLenum target, GLuint texture) const noexcep
  * @param textures Texture ID
  * @return nothing
  */
-void SGL_OpenGLManager::deleteTextures(GLsizei n, const GLuint *textures) const noexcept
+void SGL_OpenGLManager::deleteTextures(GLsizei n, const GLuint *textures) noexcept
 {
+    // Deleted textures get unbound, their IDs may be handed out again
+    for (GLsizei i = 0; i < n; ++i)
+        for (std::uint32_t unit = 0; unit < SGL_OGL_CONSTANTS::MAX_TEXTURE_UNITS; ++unit)
+            if (currentTextures[unit] == textures[i])
+                currentTextures[unit] = 0;
+
     glDeleteTextures(n, textures);
 }
 
@@ -384,6 +582,68 @@ void SGL_OpenGLManager::texImage2D(GLenum target, GLint level, GLint internalfor
     glTexImage2D(target, level, internalformat, width, height, border, format, type, data);
 }
 
+/**
+ * @brief  Replaces a region of an existing texture
+ *
+ * @param target Specifies the target texture of the active texture unit.
+ * @param level Specifies the level-of-detail number. Level 0 is the base image level.
+ * @param xoffset Specifies a texel offset in the x direction within the texture array.
+ * @param yoffset Specifies a texel offset in the y direction within the texture array.
+ * @param width Specifies the width of the texture subimage.
+ * @param height Specifies the height of the texture subimage.
+ * @param format Specifies the format of the texel data.
+ * @param type Specifies the data type of the texel data.
+ * @param data Specifies a pointer to the image data in memory.
+ *
+ * @return nothing
+ */
+void SGL_OpenGLManager::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *data) const noexcept
+{
+    glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, data);
+}
+
+
+/**
+ * @brief Returns information about an active uniform variable for the specified program object
+ *
+ * @param program Specifies the program object to be queried.
+ * @param index Specifies the index of the uniform variable to be queried.
+ * @param bufSize Specifies the maximum number of characters OpenGL is allowed to write in the character buffer indicated by name.
+ * @param length Returns the number of characters actually written by OpenGL in the string indicated by name (excluding the null terminator).
+ * @param size Returns the size of the uniform variable.
+ * @param type Returns the data type of the uniform variable.
+ * @param name Returns a null terminated string containing the name of the uniform variable.
+ * @return nothing
+ */
+void SGL_OpenGLManager::getActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) const noexcept
+{
+    glGetActiveUniform(program, index, bufSize, length, size, type, name);
+}
+
+/**
+ * @brief Retrieve the index of a named uniform block
+ *
+ * @param program Specifies the name of a program containing the uniform block.
+ * @param name Specifies the address an array of characters containing the name of the uniform block whose index to retrieve.
+ * @return GLuint Block index, GL_INVALID_INDEX if the program doesn't use it
+ */
+GLuint SGL_OpenGLManager::getUniformBlockIndex(GLuint program, const GLchar *name) const noexcept
+{
+    return glGetUniformBlockIndex(program, name);
+}
+
+/**
+ * @brief Assign a binding point to an active uniform block
+ *
+ * @param program The name of a program object containing the active uniform block whose binding to assign.
+ * @param blockIndex The index of the active uniform block within program whose binding to assign.
+ * @param binding Specifies the binding point to which to bind the uniform block with index blockIndex within program.
+ * @return nothing
+ */
+void SGL_OpenGLManager::uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint binding) const noexcept
+{
+    glUniformBlockBinding(program, blockIndex, binding);
+}
 
 /**
  * @brief Return the location of a uniform variable in a shader
@@ -525,8 +785,12 @@ void SGL_OpenGLManager::uniformMatrix4fv(GLint location, GLsizei count, GLboolea
  * @param program Shader program to delete
  * @return nothing
  */
-void SGL_OpenGLManager::deleteProgram(GLuint program) const noexcept
+void SGL_OpenGLManager::deleteProgram(GLuint program) noexcept
 {
+    // A deleted program stays in use until another one replaces it, but its ID
+    // may be reused so the next useProgram() can't be skipped
+    if (currentShaderID == program)
+        currentShaderID = 0;
     glDeleteProgram(program);
 }
 
@@ -538,6 +802,8 @@ void SGL_OpenGLManager::deleteProgram(GLuint program) const noexcept
  */
 void SGL_OpenGLManager::useProgram(GLuint program) noexcept
 {
+    if (!trackState(currentShaderID != program))
+        return;
     currentShaderID = program;
     glUseProgram(program);
 }
@@ -736,6 +1002,13 @@ void SGL_OpenGLManager::clearBuffers() noexcept
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    currentGLBuffers.currentEBO.name = "NO_EBO";
+    currentGLBuffers.currentEBO.ID = 0;
+    currentGLBuffers.currentVBO.name = "NO_VBO";
+    currentGLBuffers.currentVBO.ID = 0;
+    currentGLBuffers.currentVAO.name = "NO_VAO";
+    currentGLBuffers.currentVAO.ID = 0;
 }
 
 /**
@@ -800,12 +1073,32 @@ void SGL_OpenGLManager::deleteFBO(const std::string &name) noexcept
     }
 }
 
+/**
+ * @brief Deletes a UBO from the map
+ * @param name the UBO identifier
+ * @return nothing
+ */
+void SGL_OpenGLManager::deleteUBO(const std::string &name) noexcept
+{
+    if (UBO.find(name) != UBO.end())
+    {
+        GLBuffer byeBuffer = UBO.at(name);
+        for (std::uint32_t i = 0; i < SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS; ++i)
+            if (currentUniformBuffers[i] == byeBuffer.ID)
+                currentUniformBuffers[i] = 0;
+        glDeleteBuffers(1, &byeBuffer.ID);
+        UBO.erase(name);
+    }
+}
+
 /**
  * @brief Unbind VBO
  * @return nothing
  */
 void SGL_OpenGLManager::unbindVBO() noexcept
 {
+    if (!trackState(currentGLBuffers.currentVBO.ID != 0))
+        return;
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     currentGLBuffers.currentVBO.name = "NO_VBO";
     currentGLBuffers.currentVBO.ID = 0;
@@ -830,6 +1123,8 @@ void SGL_OpenGLManager::unbindEBO() noexcept
  */
 void SGL_OpenGLManager::unbindVAO() noexcept
 {
+    if (!trackState(currentGLBuffers.currentVAO.ID != 0))
+        return;
     glBindVertexArray(0);
     currentGLBuffers.currentVAO.name = "NO_VAO";
     currentGLBuffers.currentVAO.ID = 0;
@@ -902,6 +1197,9 @@ void SGL_OpenGLManager::depthMask(bool value) noexcept
  */
 void SGL_OpenGLManager::faceCulling(bool value) noexcept
 {
+    if (!trackState(currentGLSettings.faceCulling.active != value))
+        return;
+
     if (value)
     {
         this->enable(GL_CULL_FACE);
@@ -925,11 +1223,19 @@ void SGL_OpenGLManager::blending(bool value, BLENDING_TYPE type, GLenum sfactor,
 {
     if (value || !(type == BLENDING_TYPE::NONE))
     {
-        this->enable(GL_BLEND);
-        currentGLSettings.blending.active = true;
+        if (trackState(!currentGLSettings.blending.active))
+        {
+            this->enable(GL_BLEND);
+            currentGLSettings.blending.active = true;
+        }
 
+        // Resolve the factors first so a repeated mode can be skipped
+        GLenum src = currentBlendSrc, dst = currentBlendDst;
         if (type == BLENDING_TYPE::CUSTOM) // Use the provided sfactor & dfactor enums
-            glBlendFunc(sfactor, dfactor);
+        {
+            src = sfactor;
+            dst = dfactor;
+        }
         else // Use the convenience wrappers
         {
             switch(type)
@@ -937,36 +1243,44 @@ void SGL_OpenGLManager::blending(bool value, BLENDING_TYPE type, GLenum sfactor,
             case NONE:
                 break;
             case DEFAULT_RENDERING:
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                src = GL_SRC_ALPHA; dst = GL_ONE_MINUS_SRC_ALPHA;
                 break;
             case SPRITE_RENDERING:
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                src = GL_SRC_ALPHA; dst = GL_ONE_MINUS_SRC_ALPHA;
                 break;
             case TEXT_RENDERING:
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                src = GL_SRC_ALPHA; dst = GL_ONE_MINUS_SRC_ALPHA;
                 break;
             case PARTICLE_RENDERING:
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+                src = GL_SRC_ALPHA; dst = GL_ONE;
                 break;
             case INVISIBLE_RENDERING:
-                glBlendFunc(GL_ZERO, GL_ZERO);
+                src = GL_ZERO; dst = GL_ZERO;
                 break;
 
             case TEST_RENDERING_1:
-                glBlendFunc(GL_SRC_COLOR, GL_ZERO);
+                src = GL_SRC_COLOR; dst = GL_ZERO;
                 break;
             case TEST_RENDERING_2:
-                // glBlendFunc(GL_ONE_MINUS_SRC_ALPHA, GL_ONE);
-                glBlendFunc(GL_SRC_COLOR, GL_ONE);
+                // src = GL_ONE_MINUS_SRC_ALPHA; dst = GL_ONE;
+                src = GL_SRC_COLOR; dst = GL_ONE;
                 break;
             case TEST_RENDERING_3:
-                glBlendFunc(GL_SRC_COLOR, GL_DST_COLOR);
+                src = GL_SRC_COLOR; dst = GL_DST_COLOR;
+                break;
+            default:
                 break;
-
             }
         }
+
+        if (type != BLENDING_TYPE::NONE && trackState(src != currentBlendSrc || dst != currentBlendDst))
+        {
+            glBlendFunc(src, dst);
+            currentBlendSrc = src;
+            currentBlendDst = dst;
+        }
     }
-    else
+    else if (trackState(currentGLSettings.blending.active))
     {
         this->disable(GL_BLEND);
         currentGLSettings.blending.active = false;
@@ -998,8 +1312,11 @@ void SGL_OpenGLManager::disable(GLenum cap) const noexcept
  * @param width The line's width, defaults to 1.0f and MAY cause odd behaviour if exceeded > 10, see the OGL doucs for your OS
  * @return nothing
  */
-void SGL_OpenGLManager::lineWidth(GLfloat width) const noexcept
+void SGL_OpenGLManager::lineWidth(GLfloat width) noexcept
 {
+    if (!trackState(currentLineWidth != width))
+        return;
+    currentLineWidth = width;
     glLineWidth(width);
 }
 
@@ -1008,11 +1325,25 @@ void SGL_OpenGLManager::lineWidth(GLfloat width) const noexcept
  * @param width The pixel's width, defaults to 1.0f and MAY cause odd behaviour if exceeded > 10, see the OGL doucs for your OS
  * @return nothing
  */
-void SGL_OpenGLManager::pixelSize(GLfloat size) const noexcept
+void SGL_OpenGLManager::pixelSize(GLfloat size) noexcept
 {
+    if (!trackState(currentPointSize != size))
+        return;
+    currentPointSize = size;
     glPointSize(size);
 }
 
+/**
+ * @brief Returns the value of a simple state variable
+ * @param pname Specifies the parameter value to be returned.
+ * @param data Returns the value of the specified parameter.
+ * @return nothing
+ */
+void SGL_OpenGLManager::getIntegerv(GLenum pname, GLint *data) const noexcept
+{
+    glGetIntegerv(pname, data);
+}
+
 /**
  * @brief Resize the view port
  * @param x New x value
@@ -1106,6 +1437,8 @@ void SGL_OpenGLManager::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr
  */
 void SGL_OpenGLManager::activeTexture(GLenum texture) noexcept
 {
+    if (!trackState(currentTextureID != texture))
+        return;
     currentTextureID = texture;
     glActiveTexture(texture);
 }
@@ -1214,7 +1547,7 @@ void SGL_OpenGLManager::checkForGLErrors() noexcept
         ss << errString;
         SGL_Log("SkeletonGL OpenGL Error: " + ss.str(), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_RED);
         SGL_Log("Current shader ID: " + std::to_string(currentShaderID), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_RED);
-        SGL_Log("Current texture ID: " + std::to_string(currentTextureID), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_RED);
+        SGL_Log("Current texture unit: " + std::to_string(currentTextureID - GL_TEXTURE0), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_RED);
         SGL_Log("Current VAO: " + currentGLBuffers.currentVAO.name + " " + std::to_string(currentGLBuffers.currentVAO.ID), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_RED);
         //assert(false);
     }
@@ -54,10 +54,26 @@ private:
     std::map<std::string, GLBuffer>EBO;       ///< All the context EBOs
     std::map<std::string, GLBuffer>VAO;       ///< All the context VAOs
     std::map<std::string, GLBuffer>FBO;       ///< All the context FBOs
+    std::map<std::string, GLBuffer>UBO;       ///< All the context UBOs
     std::map<std::string, GLSetting>Settings; ///< Supported OpenGL render settings
-    GLuint currentShaderID, currentTextureID; ///< Bound shader and texture IDs
+    GLuint currentShaderID, currentTextureID; ///< Bound shader and active texture unit
     SGL_Color currentClearColor;              ///< Clear screen color
 
+    // Shadow copy of the state the wrappers below set, calls that wouldn't change
+    // anything are dropped before reaching the driver. Program, VAO and culling are
+    // tracked by the members above
+    GLuint currentTextures[SGL_OGL_CONSTANTS::MAX_TEXTURE_UNITS]; ///< GL_TEXTURE_2D bound to each unit
+    GLenum currentBlendSrc, currentBlendDst;  ///< Last glBlendFunc factors
+    GLfloat currentLineWidth, currentPointSize;
+    GLuint currentUniformBuffers[SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS];   ///< UBO bound to each binding point
+    GLintptr currentUniformOffsets[SGL_OGL_CONSTANTS::MAX_UNIFORM_BUFFER_BINDINGS]; ///< and the offset of its range
+    GLStateCounters stateCounters;            ///< Calls issued vs elided since the last reset
+
+    // Counts a state change, returns false if the call is redundant and can be skipped
+    bool trackState(bool changed) noexcept;
+    // Sets the shadow state to OpenGL's initial values without touching the context
+    void setDefaultStateCache() noexcept;
+
     // Currently, an opengl error arises when checking for
     // errors after initializing the GL context, doesn't
     // seem to affect rendering at all
@@ -83,6 +99,8 @@ public:
     void createFBO(const std::string &name) noexcept;
     // Create a RBO
     void createRBO(const std::string &name) noexcept;
+    // Create a UBO
+    void createUBO(const std::string &name) noexcept;
     // Bind the selected buffer
     void bindVBO(const std::string &name) noexcept;
     // Bind the selected buffer
@@ -91,6 +109,10 @@ public:
     void bindVAO(const std::string &name) noexcept;
     // Bind the selected FBO
     void bindFBO(const std::string &name, GLCONSTANTS::FBO type = GLCONSTANTS::RW) noexcept;
+    // Bind the selected UBO to GL_UNIFORM_BUFFER
+    void bindUBO(const std::string &name) noexcept;
+    // Bind a range of the selected UBO to a uniform block binding point
+    void bindUBORange(const std::string &name, GLuint binding, GLintptr offset, GLsizeiptr size) noexcept;
     // Unbind the current buffer
     void unbindVBO() noexcept;
     // Unbind the current EBO
@@ -109,6 +131,8 @@ public:
     void deleteVAO(const std::string &name) noexcept;
     // Deletes all the FBO
     void deleteFBO(const std::string &name) noexcept;
+    // Deletes the UBO
+    void deleteUBO(const std::string &name) noexcept;
 
     // Activates the specified shader program
     void useProgram(GLuint program) noexcept;
@@ -135,6 +159,12 @@ public:
     // Gets the program log
     void getProgramInfoLog(GLuint shader,  GLsizei maxLength, GLsizei *length, GLchar *infoLog) const noexcept;
 
+    // Gets the name, size and type of an active uniform
+    void getActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) const noexcept;
+    // Gets the index of a named uniform block
+    GLuint getUniformBlockIndex(GLuint program, const GLchar *name) const noexcept;
+    // Assigns a binding point to a uniform block
+    void uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint binding) const noexcept;
     // Sets a uniform location from the specified shader
     GLint getUniformLocation(GLuint program, const GLchar *name) const noexcept;
     // Sets a float uniform location from the specified shader
@@ -176,11 +206,11 @@ public:
     // Generate a texture
     void genTextures(GLsizei n, GLuint *textures) const noexcept;
     // Bind texture
-    void bindTexture(GLenum target, GLuint texture) const noexcept;
+    void bindTexture(GLenum target, GLuint texture) noexcept;
     // Activates a texture
     void activeTexture(GLenum texture) noexcept;
     // Deletes textures
-    void deleteTextures(GLsizei n, const GLuint *textures) const noexcept;
+    void deleteTextures(GLsizei n, const GLuint *textures) noexcept;
     // Texture pixel format
     void pixelStorei(GLenum pname, GLint param) const noexcept;
     // Texture creation parameters
@@ -189,6 +219,8 @@ public:
     void texParameterf(GLenum target, GLenum pname, GLfloat param) const noexcept;
     // Creates a 2D texture
     void texImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *data) const noexcept;
+    // Replaces a region of a 2D texture
+    void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *data) const noexcept;
 
     // Draws loaded state machine
     void drawArrays(GLenum mode, GLint first, GLsizei count) const noexcept;
@@ -207,18 +239,27 @@ public:
     // modify the rate at which generic vertex attributes advance during instanced rendering
     void vertexAttribDivisor(GLuint index, GLint divisor) const noexcept;
     // Deletes a compiled and linked shader program
-    void deleteProgram(GLuint program) const noexcept;
+    void deleteProgram(GLuint program) noexcept;
     // Generate framebuffer
     void frameBufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) const noexcept;
     // Render framebuffer
     void blitFrameBuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) const noexcept;
 
     // Set the width (float) for GL_LINES
-    void lineWidth(GLfloat width) const noexcept;
-    void pixelSize(GLfloat size) const noexcept;
+    void lineWidth(GLfloat width) noexcept;
+    void pixelSize(GLfloat size) noexcept;
+
+    // Puts every cached piece of state back to OpenGL's defaults, call it after
+    // anything touches the context without going through this manager
+    void resetStateCache() noexcept;
+    // State changing calls issued and elided by the cache
+    const GLStateCounters &getStateCounters() const noexcept;
+    void resetStateCounters() noexcept;
 
     // Checks the current FBO status
     GLenum checkFrameBufferStatus(GLenum target) const noexcept;
+    // Queries an implementation dependent value
+    void getIntegerv(GLenum pname, GLint *data) const noexcept;
     // Resize the viewport
     void resizeGL(int x, int y, int w, int h) const noexcept;
     // Error reporting
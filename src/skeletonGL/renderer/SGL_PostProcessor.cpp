@@ -132,7 +132,7 @@ void SGL_PostProcessor::reload(GLuint newWidth, GLuint newHeight)
 
     // Load buffers and init data
     this->loadBuffers();
-    this->pShader.setInteger(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_I_SCENE.c_str(), 0, GL_TRUE);
+    this->pShader.setInteger(*WMOGLM, SHADER_UNIFORM::SCENE, 0, GL_TRUE);
 
     // GLfloat offset = 1.0f / 300.0f;
     // GLfloat offsets[9][2] = {
@@ -239,10 +239,10 @@ void SGL_PostProcessor::render(const SGL_Shader &shader, UV_Wrapper *UVdata)
 
     WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
     activeShader.use(*WMOGLM);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_FBO_TEXTURE_DIMENSIONS.c_str(), pWidth, pHeight);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_MOUSE_POSITION.c_str(), activeShader.renderDetails.mousePosX, activeShader.renderDetails.mousePosY);
+    activeShader.setFloat(*WMOGLM, SHADER_UNIFORM::DELTA_TIME, activeShader.renderDetails.deltaTime);
+    activeShader.setFloat(*WMOGLM, SHADER_UNIFORM::TIME_ELAPSED, activeShader.renderDetails.timeElapsed);
+    activeShader.setVector2f(*WMOGLM, SHADER_UNIFORM::FBO_TEXTURE_DIMENSIONS, pWidth, pHeight);
+    activeShader.setVector2f(*WMOGLM, SHADER_UNIFORM::MOUSE_POSITION, activeShader.renderDetails.mousePosX, activeShader.renderDetails.mousePosY);
     // activeShader.setInteger(*WMOGLM, "confuse", this->confuse);
     // activeShader.setInteger(*WMOGLM, "chaos", this->chaos);
     // activeShader.setInteger(*WMOGLM, "shake", this->shake);
@@ -251,8 +251,6 @@ void SGL_PostProcessor::render(const SGL_Shader &shader, UV_Wrapper *UVdata)
     this->pTexture.bind(*WMOGLM);
     WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_POSTPROCESSOR_VAO);
     WMOGLM->drawArrays(GL_TRIANGLES, 0, 6);
-    WMOGLM->unbindVAO();
-    activeShader.unbind(*WMOGLM);
 }
 
 
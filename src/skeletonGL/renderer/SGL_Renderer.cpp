@@ -38,6 +38,7 @@
  * @param circleBatchShader The default circle batch shader
  * @param spriteShader The default sprite shader
  * @param spriteBatchShader The default sprite batch shader
+ * @param spriteQueueShader Instanced shader the deferred sprite queue is drawn with
  * @param textShader The default shader for the TTF text renderer
  * @return nothing
  */
@@ -48,7 +49,7 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
                            const SGL_Shader &lineShader, const SGL_Shader &lineBatchShader,
                            const SGL_Shader &circleShader, const SGL_Shader &circleBatchShader,
                            const SGL_Shader &spriteShader, const SGL_Shader &spriteBatchShader,
-                           const SGL_Shader &textShader)
+                           const SGL_Shader &spriteQueueShader, const SGL_Shader &textShader)
 {
     SGL_Log("Configuring renderer...", LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
     // Geometry shader configuration
@@ -60,6 +61,7 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
     this->pCircleShader = circleShader;
     this->pSpriteShader = spriteShader;
     this->pSpriteBatchShader = spriteBatchShader;
+    this->pSpriteQueueShader = spriteQueueShader;
     this->pPixelBatchShader = pixelBatchShader;
     this->pLineBatchShader = lineBatchShader;
     this->pCircleBatchShader = circleBatchShader;
@@ -83,6 +85,7 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
     WMOGLM->createVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_VAO);
     WMOGLM->createVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_VAO);
     WMOGLM->createVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_VAO);
+    WMOGLM->createVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VAO);
     // VBO
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_VBO);
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_VBO);
@@ -91,6 +94,7 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_VBO);
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_VBO);
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_VBO);
+    WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VBO);
     // Texture buffers: Simple buffer to hold UV data
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_TEXTURE_UV_VBO);
 
@@ -100,6 +104,7 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_INSTANCES_VBO);
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_INSTANCES_VBO);
     WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_INSTANCES_VBO);
+    WMOGLM->createVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_INSTANCES_VBO);
 
     // Load the object data
     this->loadLineBuffers(pLineShader);
@@ -108,6 +113,13 @@ SGL_Renderer::SGL_Renderer(std::shared_ptr<SGL_OpenGLManager> oglm,
     this->loadPixelBatchBuffers(pPixelBatchShader);
     this->loadSpriteBatchBuffers(pSpriteBatchShader);
     this->loadLineBatchBuffers(pLineBatchShader);
+    this->loadSpriteQueueBuffers(pSpriteQueueShader);
+
+    // The queue is sized once, a frame never allocates unless it outgrows it
+    this->pDeferred = false;
+    this->pSpriteQueue.reserve(SGL_OGL_CONSTANTS::MAX_SPRITE_BATCH_INSTANCES);
+    this->pSpriteInstances.reserve(SGL_OGL_CONSTANTS::MAX_SPRITE_BATCH_INSTANCES);
+    this->pSpriteStaging.reserve(SGL_OGL_CONSTANTS::MAX_SPRITE_BATCH_INSTANCES);
 
     this->generateBitmapFont();
     // Generate the charset from the provided TTF font
@@ -129,6 +141,7 @@ SGL_Renderer::~SGL_Renderer()
     WMOGLM->deleteVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_VAO);
     WMOGLM->deleteVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_VAO);
     WMOGLM->deleteVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_VAO);
+    WMOGLM->deleteVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VAO);
 
     // VBOs
     WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_VBO);
@@ -142,6 +155,8 @@ SGL_Renderer::~SGL_Renderer()
     WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_INSTANCES_VBO);
     WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_INSTANCES_VBO);
     WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_INSTANCES_VBO);
+    WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VBO);
+    WMOGLM->deleteVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_INSTANCES_VBO);
 }
 
 /**
@@ -150,8 +165,9 @@ SGL_Renderer::~SGL_Renderer()
  *
  * @return nothing
  */
-void SGL_Renderer::renderPixel(const SGL_Pixel &pixel) const
+void SGL_Renderer::renderPixel(const SGL_Pixel &pixel)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (pixel.shader.shaderType != SHADER_TYPE::PIXEL)
         activeShader = pPixelShader;
@@ -168,10 +184,7 @@ void SGL_Renderer::renderPixel(const SGL_Pixel &pixel) const
 
     WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(vertices), &vertices[0]);
     glm::vec4 assignedColor = {pixel.color.r, pixel.color.g, pixel.color.b, pixel.color.a};
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), assignedColor);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, assignedColor);
 
     // Pixel width, if AA is enabled it must be set to 1.0f!
     if ( pixel.size > SGL_OGL_CONSTANTS::MIN_PIXEL_SIZE && pixel.size < SGL_OGL_CONSTANTS::MAX_PIXEL_SIZE )
@@ -187,13 +200,7 @@ void SGL_Renderer::renderPixel(const SGL_Pixel &pixel) const
 
 
     WMOGLM->drawArrays(GL_POINTS, 0, 2);
-
-    // Cleanup
-    WMOGLM->pixelSize(SGL_OGL_CONSTANTS::MIN_PIXEL_SIZE);
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    activeShader.unbind(*WMOGLM);
+    ++pFrameStats.drawCalls;
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
@@ -228,8 +235,9 @@ void SGL_Renderer::renderPixel(float x1, float y1, float scale, SGL_Color color)
  *
  * @return nothing
  */
-void SGL_Renderer::renderLine(const SGL_Line &line) const
+void SGL_Renderer::renderLine(const SGL_Line &line)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (line.shader.shaderType != SHADER_TYPE::LINE)
         activeShader = pLineShader;
@@ -246,16 +254,13 @@ void SGL_Renderer::renderLine(const SGL_Line &line) const
 
     WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(vertices), &vertices[0]);
     glm::vec4 assignedColor = {line.color.r, line.color.g, line.color.b, line.color.a};
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), assignedColor);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, assignedColor);
 
     // Line width, if AA is enabled it must be set to 1.0f!
     if ( line.width > SGL_OGL_CONSTANTS::MIN_LINE_WIDTH && line.width < SGL_OGL_CONSTANTS::MAX_LINE_WIDTH )
-        glLineWidth(line.width);
+        WMOGLM->lineWidth(line.width);
     else
-        glLineWidth(SGL_OGL_CONSTANTS::MIN_LINE_WIDTH);
+        WMOGLM->lineWidth(SGL_OGL_CONSTANTS::MIN_LINE_WIDTH);
 
     // Set the blending mode
     if (line.blending == 0)
@@ -265,13 +270,7 @@ void SGL_Renderer::renderLine(const SGL_Line &line) const
 
 
     WMOGLM->drawArrays(GL_LINES, 0, 2);
-
-    // Reset line width
-    glLineWidth(SGL_OGL_CONSTANTS::MIN_LINE_WIDTH);
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    activeShader.unbind(*WMOGLM);
+    ++pFrameStats.drawCalls;
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
@@ -311,6 +310,7 @@ void SGL_Renderer::renderLine(float x1, float y1, float x2, float y2, float widt
  */
 void SGL_Renderer::renderText(SGL_Text &text)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (text.shader.shaderType != SHADER_TYPE::TEXT)
         activeShader = pTextShader;
@@ -318,11 +318,11 @@ void SGL_Renderer::renderText(SGL_Text &text)
         activeShader = text.shader;
 
     WMOGLM->faceCulling(true);
+    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
     // RESUME render state
     activeShader.use(*WMOGLM);
     glm::vec4 assignedColor = {text.color.r, text.color.g, text.color.b, text.color.a};
     activeShader.setVector4f(*WMOGLM, "textColor", assignedColor);
-    activeShader.setFloat(*WMOGLM, "deltaTime", activeShader.renderDetails.deltaTime);
     WMOGLM->activeTexture(GL_TEXTURE0);
     WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_TEXT_VAO);
 
@@ -356,17 +356,13 @@ void SGL_Renderer::renderText(SGL_Text &text)
         // Update content of VBO memory
         WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_TEXT_VBO);
         WMOGLM->bufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        WMOGLM->unbindVBO();
         // Render the quad
         WMOGLM->drawArrays(GL_TRIANGLES, 0, 6);
+        ++pFrameStats.drawCalls;
         // Advance cursor for the next glyph (note that advance is number of 1/64 pixels)
         text.position.x += (ch.advance >> 6) * text.scale;
     }
 
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    activeShader.unbind(*WMOGLM);
-    WMOGLM->bindTexture(GL_TEXTURE_2D, 0);
     WMOGLM->faceCulling(false);
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
@@ -386,13 +382,12 @@ void SGL_Renderer::renderText(SGL_Text &text)
  */
 void SGL_Renderer::renderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color)
 {
+    this->flush();
     WMOGLM->faceCulling(true);
+    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
     // RESUME render state
     this->pTextShader.use(*WMOGLM);
-    this->pTextShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), color.r, color.g, color.b, color.a);
-    this->pTextShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), this->pTextShader.renderDetails.deltaTime);
-    this->pTextShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), this->pTextShader.renderDetails.timeElapsed);
-    this->pTextShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), this->pTextShader.renderDetails.canvasWidth, this->pTextShader.renderDetails.canvasHeight);
+    this->pTextShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, color.r, color.g, color.b, color.a);
 
     WMOGLM->activeTexture(GL_TEXTURE0);
     WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_TEXT_VAO);
@@ -427,17 +422,13 @@ void SGL_Renderer::renderText(std::string text, GLfloat x, GLfloat y, GLfloat sc
         // Update content of VBO memory
         WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_TEXT_VBO);
         WMOGLM->bufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        WMOGLM->unbindVBO();
         // Render the quad
         WMOGLM->drawArrays(GL_TRIANGLES, 0, 6);
+        ++pFrameStats.drawCalls;
         // Advance cursor for the next glyph (note that advance is number of 1/64 pixels)
         x += (ch.advance >> 6) * scale;
     }
 
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    this->pTextShader.unbind(*WMOGLM);
-    WMOGLM->bindTexture(GL_TEXTURE_2D, 0);
     WMOGLM->faceCulling(false);
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
@@ -456,7 +447,7 @@ void SGL_Renderer::renderText(std::string text, GLfloat x, GLfloat y, GLfloat sc
  *
  * @return nothing
  */
-void SGL_Renderer::renderBitmapText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color) const
+void SGL_Renderer::renderBitmapText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color)
 {
     SGL_Bitmap_Text t;
     t.text = text;
@@ -475,7 +466,7 @@ void SGL_Renderer::renderBitmapText(std::string text, GLfloat x, GLfloat y, GLfl
  *
  * @return nothing
  */
-void SGL_Renderer::renderBitmapText(SGL_Bitmap_Text &text) const
+void SGL_Renderer::renderBitmapText(SGL_Bitmap_Text &text)
 {
     // Get the UV positioning for the character to rener
     SGL_Sprite s;
@@ -524,7 +515,7 @@ void SGL_Renderer::renderCircle(float x, float y, float radius, float width, SGL
 }
 
 
-void SGL_Renderer::renderCircle(const SGL_Circle &circle) const
+void SGL_Renderer::renderCircle(const SGL_Circle &circle)
 {
     SGL_Sprite c;
     // Do this check here before passing the sprite to the sprite renderer, otherwise if the incorrect shader type is passed
@@ -554,10 +545,40 @@ void SGL_Renderer::renderCircle(const SGL_Circle &circle) const
  *
  * @return nothing
  */
-void SGL_Renderer::renderSprite(const SGL_Sprite &sprite) const
+void SGL_Renderer::renderSprite(const SGL_Sprite &sprite)
 {
+    ++pFrameStats.sprites;
+    bool defaultShader = (sprite.shader.shaderType != SHADER_TYPE::SPRITE || sprite.shader.ID == pSpriteShader.ID);
+
+    // Only the default shader has an instanced twin, custom ones are drawn right away
+    if (pDeferred && defaultShader)
+    {
+        const SGL_Texture &texture = (sprite.texture.width == 0) ? pDefaultTexture : sprite.texture;
+
+        SpriteInstance instance;
+        instance.model = glm::translate(glm::mat4(1.0f), glm::vec3(sprite.position + sprite.rotationOrigin, 0.0f));
+        if (sprite.rotation != 0.0f)
+            instance.model = glm::rotate(instance.model, sprite.rotation, glm::vec3(0.0f, 0.0f, 1.0f));
+        instance.model = glm::translate(instance.model, glm::vec3(-sprite.rotationOrigin, 0.0f));
+        instance.model = glm::scale(instance.model, glm::vec3(sprite.size, 1.0f));
+        // The base quad maps (0, 0) to the bottom left corner and (1, 1) to the top right
+        instance.uvRect = glm::vec4(texture.normalizeUV(sprite.uvCoords.UV_botLeft), texture.normalizeUV(sprite.uvCoords.UV_topRight));
+        instance.color = glm::vec4(sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
+
+        SpriteCommand command;
+        command.key = (static_cast<std::uint64_t>(sprite.layer) << 56) |
+            (static_cast<std::uint64_t>((sprite.blending == 0) ? BLENDING_TYPE::DEFAULT_RENDERING : sprite.blending) << 48) |
+            texture.ID;
+        command.sequence = static_cast<std::uint32_t>(pSpriteInstances.size());
+        pSpriteQueue.push_back(command);
+        pSpriteInstances.push_back(instance);
+        ++pFrameStats.queuedSprites;
+        return;
+    }
+    this->flush();
+
     SGL_Shader activeShader;
-    if (sprite.shader.shaderType != SHADER_TYPE::SPRITE)
+    if (defaultShader)
         activeShader = pSpriteShader;
     else
         activeShader = sprite.shader;
@@ -568,14 +589,17 @@ void SGL_Renderer::renderSprite(const SGL_Sprite &sprite) const
     else
         activeTexture = sprite.texture;
 
+    // Normalized with the texture's precomputed texel size, atlas regions land in their page
+    glm::vec2 topLeft = activeTexture.normalizeUV(sprite.uvCoords.UV_topLeft), topRight = activeTexture.normalizeUV(sprite.uvCoords.UV_topRight);
+    glm::vec2 botLeft = activeTexture.normalizeUV(sprite.uvCoords.UV_botLeft), botRight = activeTexture.normalizeUV(sprite.uvCoords.UV_botRight);
     GLfloat UV[] = {
-        sprite.uvCoords.UV_topLeft.x / sprite.texture.width, sprite.uvCoords.UV_topLeft.y / sprite.texture.height,
-        sprite.uvCoords.UV_botRight.x / sprite.texture.width, sprite.uvCoords.UV_botRight.y / sprite.texture.height,
-        sprite.uvCoords.UV_botLeft.x / sprite.texture.width, sprite.uvCoords.UV_botLeft.y / sprite.texture.height,
+        topLeft.x, topLeft.y,
+        botRight.x, botRight.y,
+        botLeft.x, botLeft.y,
 
-        sprite.uvCoords.UV_topLeft.x / sprite.texture.width, sprite.uvCoords.UV_topLeft.y / sprite.texture.height,
-        sprite.uvCoords.UV_topRight.x / sprite.texture.width, sprite.uvCoords.UV_topRight.y / sprite.texture.height,
-        sprite.uvCoords.UV_botRight.x / sprite.texture.width, sprite.uvCoords.UV_botRight.y / sprite.texture.height,
+        topLeft.x, topLeft.y,
+        topRight.x, topRight.y,
+        botRight.x, botRight.y,
     };
 
     WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_VAO);
@@ -601,31 +625,126 @@ void SGL_Renderer::renderSprite(const SGL_Sprite &sprite) const
     model = glm::scale(model, glm::vec3(sprite.size, 1.0f)); //scale
 
     // Parse uniforms
-    activeShader.setMatrix4(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_M4F_MODEL.c_str(), model);
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setMatrix4(*WMOGLM, SHADER_UNIFORM::MODEL, model);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
     // Circles are just transparent textures used as canvases, just parse it fuck it
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_CIRCLE_BORDER_WIDTH.c_str(), activeShader.renderDetails.circleBorder);
+    activeShader.setFloat(*WMOGLM, SHADER_UNIFORM::CIRCLE_BORDER_WIDTH, activeShader.renderDetails.circleBorder);
 
     // Activate the texture
     WMOGLM->activeTexture(GL_TEXTURE0);
     activeTexture.bind(*WMOGLM);
 
     WMOGLM->drawArrays(GL_TRIANGLES, 0, 6);
+    ++pFrameStats.drawCalls;
 
-    // Cleanup
-    activeShader.unbind(*WMOGLM);
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
+    // Nothing is unbound afterwards, the next draw binds over this one's state and
+    // the manager skips whatever it already has bound
+
+#ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
+    WMOGLM->checkForGLErrors();
+#endif
+}
+
+/**
+ * @brief Toggles the deferred sprite queue, turning it off draws whatever is queued
+ * @param deferred Queue default shader sprites instead of drawing them right away
+ *
+ * @return nothing
+ */
+void SGL_Renderer::setDeferred(bool deferred)
+{
+    if (!deferred)
+        this->flush();
+    this->pDeferred = deferred;
+}
+
+/**
+ * @brief Are default shader sprites being queued
+ *
+ * @return bool True if deferred
+ */
+bool SGL_Renderer::isDeferred() const noexcept
+{
+    return pDeferred;
+}
+
+/**
+ * @brief Draws the queued sprites, sorted into as few instanced draws as possible
+ *
+ * Every run of sprites sharing a layer, blending mode and texture goes out in a single
+ * draw, split only if it's bigger than the instance buffer
+ *
+ * @return nothing
+ */
+void SGL_Renderer::flush()
+{
+    if (pSpriteQueue.empty())
+        return;
+
+    std::sort(pSpriteQueue.begin(), pSpriteQueue.end(), [](const SpriteCommand &a, const SpriteCommand &b)
+    {
+        return (a.key < b.key) || (a.key == b.key && a.sequence < b.sequence);
+    });
+    // Instance data in draw order, so every batch is one contiguous upload
+    pSpriteStaging.clear();
+    for (const SpriteCommand &command : pSpriteQueue)
+        pSpriteStaging.push_back(pSpriteInstances[command.sequence]);
+
+    WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VAO);
+    pSpriteQueueShader.use(*WMOGLM);
+    WMOGLM->activeTexture(GL_TEXTURE0);
+    WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_INSTANCES_VBO);
+
+    std::size_t first = 0, total = pSpriteQueue.size();
+    while (first < total)
+    {
+        std::uint64_t key = pSpriteQueue[first].key;
+        std::size_t last = first + 1;
+        while (last < total && pSpriteQueue[last].key == key && (last - first) < SGL_OGL_CONSTANTS::MAX_SPRITE_BATCH_INSTANCES)
+            ++last;
+
+        WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(SpriteInstance) * (last - first), &pSpriteStaging[first]);
+        WMOGLM->blending(true, static_cast<BLENDING_TYPE>((key >> 48) & 0xFF));
+        WMOGLM->bindTexture(GL_TEXTURE_2D, static_cast<GLuint>(key & 0xFFFFFFFF));
+        WMOGLM->drawArraysInstanced(GL_TRIANGLES, 0, 6, last - first);
+        ++pFrameStats.batches;
+        ++pFrameStats.drawCalls;
+        first = last;
+    }
+
+    pSpriteQueue.clear();
+    pSpriteInstances.clear();
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
 #endif
 }
 
+/**
+ * @brief Draws whatever is still queued and starts counting a new frame
+ *
+ * @return nothing
+ */
+void SGL_Renderer::endFrame()
+{
+    this->flush();
+    this->pFrameStats.stateCallsIssued = WMOGLM->getStateCounters().issued;
+    this->pFrameStats.stateCallsElided = WMOGLM->getStateCounters().elided;
+    WMOGLM->resetStateCounters();
+    this->pLastFrameStats = pFrameStats;
+    this->pFrameStats = SGL_RenderStats();
+}
+
+/**
+ * @brief Returns the draw call counters of the last finished frame
+ *
+ * @return SGL_RenderStats Last frame's counters
+ */
+const SGL_RenderStats &SGL_Renderer::getFrameStats() const noexcept
+{
+    return pLastFrameStats;
+}
+
 /**
  * @brief Renders a sprite batch using instanced rendering
  * @param sprite SGL_Sprite to be rendered
@@ -635,6 +754,7 @@ void SGL_Renderer::renderSprite(const SGL_Sprite &sprite) const
  */
 void SGL_Renderer::renderSpriteBatch(const SGL_Sprite &sprite, const std::vector<glm::mat4> *matrices)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (sprite.shader.shaderType != SHADER_TYPE::SPRITE_BATCH)
         activeShader = pSpriteBatchShader;
@@ -643,14 +763,16 @@ void SGL_Renderer::renderSpriteBatch(const SGL_Sprite &sprite, const std::vector
 
     // activeShader = pSpriteBatchShader;
 
+    glm::vec2 topLeft = sprite.texture.normalizeUV(sprite.uvCoords.UV_topLeft), topRight = sprite.texture.normalizeUV(sprite.uvCoords.UV_topRight);
+    glm::vec2 botLeft = sprite.texture.normalizeUV(sprite.uvCoords.UV_botLeft), botRight = sprite.texture.normalizeUV(sprite.uvCoords.UV_botRight);
     GLfloat UV[] = {
-        sprite.uvCoords.UV_topLeft.x / sprite.texture.width, sprite.uvCoords.UV_topLeft.y / sprite.texture.height,
-        sprite.uvCoords.UV_botRight.x / sprite.texture.width, sprite.uvCoords.UV_botRight.y / sprite.texture.height,
-        sprite.uvCoords.UV_botLeft.x / sprite.texture.width, sprite.uvCoords.UV_botLeft.y / sprite.texture.height,
+        topLeft.x, topLeft.y,
+        botRight.x, botRight.y,
+        botLeft.x, botLeft.y,
 
-        sprite.uvCoords.UV_topLeft.x / sprite.texture.width, sprite.uvCoords.UV_topLeft.y / sprite.texture.height,
-        sprite.uvCoords.UV_topRight.x / sprite.texture.width, sprite.uvCoords.UV_topRight.y / sprite.texture.height,
-        sprite.uvCoords.UV_botRight.x / sprite.texture.width, sprite.uvCoords.UV_botRight.y / sprite.texture.height,
+        topLeft.x, topLeft.y,
+        topRight.x, topRight.y,
+        botRight.x, botRight.y,
     };
 
     // Activate VAO & load shader
@@ -670,27 +792,18 @@ void SGL_Renderer::renderSpriteBatch(const SGL_Sprite &sprite, const std::vector
     // Update the batch data buffer
     WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_BATCH_INSTANCES_VBO);
     WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(glm::mat4) * matrices->size(), matrices->data());
-    WMOGLM->unbindVBO();
 
     // Parse uniforms
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, sprite.color.r, sprite.color.g, sprite.color.b, sprite.color.a);
     // Circles are just transparent textures used as canvases, just parse it fuck it
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_CIRCLE_BORDER_WIDTH.c_str(), activeShader.renderDetails.circleBorder);
+    activeShader.setFloat(*WMOGLM, SHADER_UNIFORM::CIRCLE_BORDER_WIDTH, activeShader.renderDetails.circleBorder);
 
     // Activate textures
     WMOGLM->activeTexture(GL_TEXTURE0);
     sprite.texture.bind(*WMOGLM);
 
     WMOGLM->drawArraysInstanced(GL_TRIANGLES, 0, 6, matrices->size());
-
-    // Cleanup
-    activeShader.unbind(*WMOGLM);
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
+    ++pFrameStats.drawCalls;
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
@@ -702,6 +815,7 @@ void SGL_Renderer::renderSpriteBatch(const SGL_Sprite &sprite, const std::vector
 
 void SGL_Renderer::renderLineBatch(const SGL_Line &line, const std::vector<glm::vec2> *vectors)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (line.shader.shaderType != SHADER_TYPE::LINE_BATCH)
         activeShader = pLineBatchShader;
@@ -719,14 +833,10 @@ void SGL_Renderer::renderLineBatch(const SGL_Line &line, const std::vector<glm::
     // Update the batch list
     WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_LINE_BATCH_INSTANCES_VBO);
     WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(glm::vec4) * vectors->size(), vectors->data());
-    WMOGLM->unbindVBO();
 
     // Set shader uniforms
     glm::vec4 assignedColor = {line.color.r, line.color.g, line.color.b, line.color.a};
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), assignedColor);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, assignedColor);
 
     // Line width, if AA is enabled it must be set to 1.0f!
     if ( line.width > SGL_OGL_CONSTANTS::MIN_LINE_WIDTH && line.width < SGL_OGL_CONSTANTS::MAX_LINE_WIDTH )
@@ -742,13 +852,7 @@ void SGL_Renderer::renderLineBatch(const SGL_Line &line, const std::vector<glm::
 
     // Render instanced data
     WMOGLM->drawArraysInstanced(GL_LINES, 0, 2, vectors->size());
-
-    // Cleanup
-    WMOGLM->lineWidth(SGL_OGL_CONSTANTS::MIN_LINE_WIDTH);
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    activeShader.unbind(*WMOGLM);
+    ++pFrameStats.drawCalls;
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
@@ -758,6 +862,7 @@ void SGL_Renderer::renderLineBatch(const SGL_Line &line, const std::vector<glm::
 
 void SGL_Renderer::renderPixelBatch(const SGL_Pixel &pixel, const std::vector<glm::vec2> *vectors)
 {
+    this->flush();
     SGL_Shader activeShader;
     if (pixel.shader.shaderType != SHADER_TYPE::PIXEL_BATCH)
         activeShader = pPixelBatchShader;
@@ -771,14 +876,10 @@ void SGL_Renderer::renderPixelBatch(const SGL_Pixel &pixel, const std::vector<gl
     // Update batch data
     WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_PIXEL_BATCH_INSTANCES_VBO);
     WMOGLM->bufferSubData(GL_ARRAY_BUFFER, NULL, sizeof(glm::vec2) * vectors->size(), vectors->data());
-    WMOGLM->unbindVBO();
 
     // Set shader uniforms
     glm::vec4 assignedColor = {pixel.color.r, pixel.color.g, pixel.color.b, pixel.color.a};
-    activeShader.setVector4f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR.c_str(), assignedColor);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME.c_str(), activeShader.renderDetails.deltaTime);
-    activeShader.setFloat(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED.c_str(), activeShader.renderDetails.timeElapsed);
-    activeShader.setVector2f(*WMOGLM, SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS.c_str(), activeShader.renderDetails.canvasWidth, activeShader.renderDetails.canvasHeight);
+    activeShader.setVector4f(*WMOGLM, SHADER_UNIFORM::COLOR, assignedColor);
 
 
     // Pixel width, if AA is enabled it must be set to 1.0f!
@@ -796,13 +897,7 @@ void SGL_Renderer::renderPixelBatch(const SGL_Pixel &pixel, const std::vector<gl
 
     // Render instanced data
     WMOGLM->drawArraysInstanced(GL_POINTS, 0, 2, vectors->size());
-
-    // Cleanup
-    WMOGLM->unbindVAO();
-    WMOGLM->unbindVBO();
-    WMOGLM->pixelSize(SGL_OGL_CONSTANTS::MIN_PIXEL_SIZE);
-    WMOGLM->blending(true, BLENDING_TYPE::DEFAULT_RENDERING);
-    activeShader.unbind(*WMOGLM);
+    ++pFrameStats.drawCalls;
 
 #ifdef SGL_CHECK_FOR_ERRORS_ON_RENDER
     WMOGLM->checkForGLErrors();
@@ -1097,7 +1192,54 @@ void SGL_Renderer::loadSpriteBatchBuffers(SGL_Shader shader) noexcept
 }
 
 
+/**
+ * @brief Load the deferred sprite queue buffers
+ * @param shader SGL_Shader the queue is flushed with
+ *               MUST COINCIDE WITH THE SAME ATTRIB LOCATIONS USED IN SHADER
+ * @return nothing
+ */
+void SGL_Renderer::loadSpriteQueueBuffers(SGL_Shader shader) noexcept
+{
+    SGL_Log("Configuring the deferred sprite renderer...", LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
+    // The base quad, its UVs are the same 0 to 1 values so both attributes read from it.
+    // The actual texture region comes with every instance
+    GLfloat vertices[] = {
+        0.0f, 1.0f,
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+
+        0.0f, 1.0f,
+        1.0f, 1.0f,
+        1.0f, 0.0f,
+    };
+
+    WMOGLM->bindVAO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VAO);
+    shader.use(*WMOGLM);
+
+    WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_VBO);
+    WMOGLM->bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    WMOGLM->enableVertexAttribArray(0);
+    WMOGLM->vertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)0);
+    WMOGLM->enableVertexAttribArray(1);
+    WMOGLM->vertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*)0);
+
+    // Instance data, refilled by every batch flush() draws
+    GLsizei stride = sizeof(SpriteInstance), vec4Size = sizeof(glm::vec4);
+    WMOGLM->bindVBO(SGL_OGL_CONSTANTS::SGL_RENDERER_SPRITE_QUEUE_INSTANCES_VBO);
+    WMOGLM->bufferData(GL_ARRAY_BUFFER, stride * SGL_OGL_CONSTANTS::MAX_SPRITE_BATCH_INSTANCES, NULL, GL_DYNAMIC_DRAW);
+    // Model matrix (3 to 6), UV region (7) and color (8)
+    for (GLuint i = 0; i < 6; ++i)
+    {
+        WMOGLM->enableVertexAttribArray(3 + i);
+        WMOGLM->vertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, stride, (void*)(i * vec4Size));
+        WMOGLM->vertexAttribDivisor(3 + i, 1);
+    }
+    WMOGLM->checkForGLErrors();
 
+    WMOGLM->unbindVAO();
+    WMOGLM->unbindVBO();
+    shader.unbind(*WMOGLM);
+}
 
 /**
  * @brief Generates a character texture based on the font to load
@@ -29,6 +29,8 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <vector>
+#include <algorithm>
 
 // GLM
 #include "../deps/glm/glm.hpp"
@@ -62,6 +64,7 @@ public:
     bool enableCustomUV;                         ///< Does the sprite require custom UV values
     SGL_Shader shader;                           ///< Sprite shader
     BLENDING_TYPE blending;                      ///< Blending type
+    std::uint8_t layer;                          ///< Draw order in the deferred queue, higher layers go on top
 
     // Reset the UV coordinates to show the full texture
     void resetUVCoords() noexcept
@@ -98,7 +101,7 @@ public:
         }
 
 
-    SGL_Sprite() : enableCustomUV(false), position(0.0f), size(0.0f), rotationOrigin(0.0f), rotation(0.0f), blending(DEFAULT_RENDERING) {}
+    SGL_Sprite() : enableCustomUV(false), position(0.0f), size(0.0f), rotationOrigin(0.0f), rotation(0.0f), blending(DEFAULT_RENDERING), layer(0) {}
 };
 
 
@@ -175,6 +178,27 @@ struct SGL_Bitmap_Text
 };
 
 
+/**
+ * @brief Draw call counters of a single frame
+ * @section DESCRIPTION
+ *
+ * Filled in by the SGL_Renderer as it goes, see SGL_Renderer::getFrameStats()
+ */
+struct SGL_RenderStats
+{
+    std::uint32_t drawCalls;                     ///< Draw calls actually issued
+    std::uint32_t sprites;                       ///< Sprites submitted, queued or not
+    std::uint32_t queuedSprites;                 ///< Sprites that went through the deferred queue
+    std::uint32_t batches;                       ///< Instanced draws the queue was flushed as
+    std::uint64_t stateCallsIssued;              ///< OpenGL state changes that reached the driver
+    std::uint64_t stateCallsElided;              ///< Redundant state changes the OpenGL manager dropped
+
+    // Draw calls the frame would have taken with every queued sprite drawn on its own
+    std::uint32_t unbatchedDrawCalls() const noexcept { return drawCalls - batches + queuedSprites; }
+
+    SGL_RenderStats() : drawCalls(0), sprites(0), queuedSprites(0), batches(0), stateCallsIssued(0), stateCallsElided(0) {}
+};
+
 /**
  * @brief Manages the rendering process and setup
  * @section DESCRIPTION
@@ -194,6 +218,7 @@ private:
     SGL_Shader pTextShader;                      ///< Text rendering shader
     SGL_Shader pSpriteShader;                    ///< Sprite shader
     SGL_Shader pSpriteBatchShader;               ///< Sprite batch shader
+    SGL_Shader pSpriteQueueShader;               ///< Instanced shader the deferred sprite queue is flushed with
     SGL_Shader pLineShader, pPixelShader;        ///< Shader for the line and pixel renderers
     SGL_Shader pPixelBatchShader;                ///< Pixel batch shader
     SGL_Shader pLineBatchShader;                 ///< Pixel batch shader
@@ -215,6 +240,26 @@ private:
     // Line BATCHING
     std::uint32_t pLineBatchAmount;              ///< Maximum amount of linex to render at once (CASUES SEGFAULT IF EXCEEDED!)
 
+    // DEFERRED SPRITES
+    // Per sprite data as laid out in the queue's instance buffer
+    struct SpriteInstance
+    {
+        glm::mat4 model;
+        glm::vec4 uvRect;                        ///< Normalized texture region, left bottom right top
+        glm::vec4 color;
+    };
+    // Sort key of a queued sprite, layer, blending and texture from the most significant bits
+    // down. Sequence is the submission order, keeps the sort stable and indexes pSpriteInstances
+    struct SpriteCommand
+    {
+        std::uint64_t key;
+        std::uint32_t sequence;
+    };
+    bool pDeferred;                              ///< Are default shader sprites being queued
+    std::vector<SpriteCommand> pSpriteQueue;
+    std::vector<SpriteInstance> pSpriteInstances, pSpriteStaging;
+    SGL_RenderStats pFrameStats, pLastFrameStats;
+
     // Its important to point out that the individual pixel, line and sprite renderers
     // have independent VBO, VAO and shaders
 
@@ -229,6 +274,7 @@ private:
     // Load all the required sprite buffers
     void loadSpriteBuffers(SGL_Shader shader) noexcept;
     void loadSpriteBatchBuffers(SGL_Shader shader) noexcept;
+    void loadSpriteQueueBuffers(SGL_Shader shader) noexcept;
 
     // Load and generate the ttf font
     void generateTTFFont(const std::string fontPath);
@@ -251,27 +297,40 @@ public:
                  const SGL_Shader &lineShader, const SGL_Shader &lineBatchShader,
                  const SGL_Shader &circleShader, const SGL_Shader &circleBatchShader,
                  const SGL_Shader &spriteShader, const SGL_Shader &spriteBatchShader,
-                 const SGL_Shader &textShader);
+                 const SGL_Shader &spriteQueueShader, const SGL_Shader &textShader);
 
     // Destructor
     ~SGL_Renderer();
 
-    void renderLine(const SGL_Line &line) const;
+    // DEFERRED RENDERING
+    // While deferred, sprites using the default sprite shader are queued instead of drawn, the
+    // queue is sorted by layer, blending and texture and drawn as instanced batches on flush().
+    // Sprites on the same layer can be drawn in any order, anything else rendered flushes first
+    void setDeferred(bool deferred);
+    bool isDeferred() const noexcept;
+    // Draws everything queued so far, call it before changing any state the sprites depend on
+    void flush();
+    // Flushes and starts counting a new frame
+    void endFrame();
+    // Counters of the last finished frame
+    const SGL_RenderStats &getFrameStats() const noexcept;
+
+    void renderLine(const SGL_Line &line);
     void renderLine(float x1, float y1, float x2, float y2, float width, SGL_Color color);
 
     void renderPixel(float x1, float y1, float scale, SGL_Color color);
-    void renderPixel(const SGL_Pixel &pixel) const;
+    void renderPixel(const SGL_Pixel &pixel);
 
     void renderText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color);
     void renderText(SGL_Text &text);
 
-    void renderBitmapText(SGL_Bitmap_Text &text) const;
-    void renderBitmapText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color) const;
+    void renderBitmapText(SGL_Bitmap_Text &text);
+    void renderBitmapText(std::string text, GLfloat x, GLfloat y, GLfloat scale, SGL_Color color);
 
     void renderCircle(float x, float y, float radius, float width, SGL_Color color);
-    void renderCircle(const SGL_Circle &circle) const; // Circles are just invisible sprites used as canvas
+    void renderCircle(const SGL_Circle &circle); // Circles are just invisible sprites used as canvas
 
-    void renderSprite(const SGL_Sprite &sprite) const;
+    void renderSprite(const SGL_Sprite &sprite);
     // BATCH / INSTANCE RENDERING
     void renderSpriteBatch(const SGL_Sprite &sprite, const std::vector<glm::mat4> *matrices);
     void renderLineBatch(const SGL_Line &line, const std::vector<glm::vec2> *vectors);
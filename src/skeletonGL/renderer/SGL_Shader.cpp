@@ -23,9 +23,25 @@
 
 // C++
 #include "iostream"
+#include <cstring>
 
 #include "SGL_Shader.hpp"
 
+// Names behind each SHADER_UNIFORM handle, same order as the enum
+static const std::string *const STANDARD_UNIFORM_NAMES[static_cast<int>(SHADER_UNIFORM::END_ENUM)] =
+{
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_V4F_COLOR,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_DELTA_TIME,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_TIME_ELAPSED,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_WINDOW_DIMENSIONS,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_M4F_MODEL,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_M4F_PROJECTION,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_F_CIRCLE_BORDER_WIDTH,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_I_SCENE,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_FBO_TEXTURE_DIMENSIONS,
+    &SGL_OGL_CONSTANTS::SHADER_UNIFORM_V2F_MOUSE_POSITION
+};
+
 
 /**
  * @brief Constructor
@@ -116,6 +132,11 @@ void SGL_Shader::compileShaders(SGL_OpenGLManager &oglm, SHADER_TYPE shaderType,
     this->shaderType = shaderType;
 
     checkForErrors(oglm, this->ID, "PROGRAM");
+    this->loadUniforms(oglm);
+    // Shaders reading the per frame block get it from its fixed binding point
+    GLuint frameBlock = oglm.getUniformBlockIndex(this->ID, SGL_OGL_CONSTANTS::FRAME_UNIFORMS_BLOCK.c_str());
+    if (frameBlock != GL_INVALID_INDEX)
+        oglm.uniformBlockBinding(this->ID, frameBlock, SGL_OGL_CONSTANTS::FRAME_UNIFORMS_BINDING);
 
     oglm.deleteShader(sVertex);
     oglm.deleteShader(sFragment);
@@ -124,6 +145,117 @@ void SGL_Shader::compileShaders(SGL_OpenGLManager &oglm, SHADER_TYPE shaderType,
 }
 
 
+/**
+ * @brief Builds the uniform table of the just linked program, every copy of this
+ * shader shares it
+ * @param oglm The windows OpenGL context
+ *
+ * @return nothing
+ */
+void SGL_Shader::loadUniforms(SGL_OpenGLManager &oglm)
+{
+    this->pUniforms = std::make_shared<SGL_UniformTable>();
+
+    GLint count = 0;
+    oglm.getProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLchar uniformName[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        oglm.getActiveUniform(this->ID, i, sizeof(uniformName), &length, &size, &type, uniformName);
+
+        SGL_UniformSlot slot;
+        slot.location = oglm.getUniformLocation(this->ID, uniformName);
+        // Uniform block members have no location, they're fed through their buffer
+        if (slot.location == -1)
+            continue;
+        slot.name.assign(uniformName, length);
+        if (slot.name.size() > 3 && slot.name.compare(slot.name.size() - 3, 3, "[0]") == 0)
+            slot.name.resize(slot.name.size() - 3);
+        slot.type = type;
+        this->pUniforms->slots.push_back(slot);
+    }
+
+    for (int i = 0; i < static_cast<int>(SHADER_UNIFORM::END_ENUM); ++i)
+        this->pUniforms->standard[i] = this->uniformIndex(STANDARD_UNIFORM_NAMES[i]->c_str());
+
+#ifdef SGL_OUTPUT_OPENGL_DETAILS
+    SGL_Log("Shader " + std::to_string(this->ID) + " has " + std::to_string(this->pUniforms->slots.size()) + " active uniforms",
+            LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_CYAN);
+#endif
+}
+
+/**
+ * @brief Finds a uniform in the table
+ * @param name Variable to look for
+ *
+ * @return std::int16_t Table slot, UNIFORM_INACTIVE or UNIFORM_UNKNOWN
+ */
+std::int16_t SGL_Shader::uniformIndex(const GLchar *name) const noexcept
+{
+    if (!this->pUniforms)
+        return UNIFORM_UNKNOWN;
+
+    for (std::size_t i = 0; i < this->pUniforms->slots.size(); ++i)
+        if (this->pUniforms->slots[i].name == name)
+            return static_cast<std::int16_t>(i);
+
+    // Array elements past the first aren't in the table, let OpenGL resolve those
+    return (std::strchr(name, '[') != nullptr) ? UNIFORM_UNKNOWN : UNIFORM_INACTIVE;
+}
+
+/**
+ * @brief Finds a default uniform in the table
+ * @param uniform Uniform handle
+ *
+ * @return std::int16_t Table slot, UNIFORM_INACTIVE or UNIFORM_UNKNOWN
+ */
+std::int16_t SGL_Shader::uniformIndex(SHADER_UNIFORM uniform) const noexcept
+{
+    if (!this->pUniforms)
+        return UNIFORM_UNKNOWN;
+    return this->pUniforms->standard[static_cast<int>(uniform)];
+}
+
+/**
+ * @brief Checks a new value against the last one uploaded to the uniform
+ * @param oglm The windows OpenGL context
+ * @param index Table slot of the uniform
+ * @param name Variable name, only used when the slot is unknown
+ * @param value Raw value to upload
+ * @param size Size of the value in bytes, 64 at most
+ *
+ * @return GLint Location to upload to, -1 if there's nothing to do
+ */
+GLint SGL_Shader::uploadLocation(SGL_OpenGLManager &oglm, std::int16_t index, const GLchar *name, const void *value, std::size_t size) noexcept
+{
+    if (index == UNIFORM_UNKNOWN)
+        return oglm.getUniformLocation(this->ID, name);
+    if (index == UNIFORM_INACTIVE)
+        return -1;
+
+    SGL_UniformSlot &slot = this->pUniforms->slots[index];
+    if (slot.cached && std::memcmp(slot.value, value, size) == 0)
+        return -1;
+
+    std::memcpy(slot.value, value, size);
+    slot.cached = true;
+    return slot.location;
+}
+
+/**
+ * @brief Whether the program uses one of the default uniforms
+ * @param uniform Uniform handle
+ *
+ * @return bool True if it's active
+ */
+bool SGL_Shader::hasUniform(SHADER_UNIFORM uniform) const noexcept
+{
+    return this->uniformIndex(uniform) >= 0;
+}
+
 /**
  * @brief Sets a single float value
  * @param oglm The windows OpenGL context
@@ -137,9 +269,12 @@ void SGL_Shader::setFloat(SGL_OpenGLManager &oglm, const GLchar *name, GLfloat v
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform1f(glGetUniformLocation(this->ID, name), value);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform1f(location, value);
 }
 
+
 /**
  * @brief Sets a single integer value
  * @param oglm The windows OpenGL context
@@ -153,9 +288,12 @@ void SGL_Shader::setInteger(SGL_OpenGLManager &oglm, const GLchar *name, GLint v
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform1i(glGetUniformLocation(this->ID, name), value);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform1i(location, value);
 }
 
+
 /**
  * @brief Sets a 2D vector
  * @param oglm The windows OpenGL context
@@ -170,7 +308,10 @@ void SGL_Shader::setVector2f(SGL_OpenGLManager &oglm, const GLchar *name, GLfloa
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform2f(glGetUniformLocation(this->ID, name), x, y);
+    const GLfloat value[2] = {x, y};
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, value, sizeof(value));
+    if (location != -1)
+        oglm.uniform2f(location, x, y);
 }
 
 
@@ -187,7 +328,9 @@ void SGL_Shader::setVector2f(SGL_OpenGLManager &oglm, const GLchar *name, glm::v
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform2f(location, value.x, value.y);
 }
 
 
@@ -206,7 +349,10 @@ void SGL_Shader::setVector3f(SGL_OpenGLManager &oglm, const GLchar *name, GLfloa
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+    const GLfloat value[3] = {x, y, z};
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, value, sizeof(value));
+    if (location != -1)
+        oglm.uniform3f(location, x, y, z);
 }
 
 
@@ -223,7 +369,9 @@ void SGL_Shader::setVector3f(SGL_OpenGLManager &oglm, const GLchar *name, glm::v
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform3f(location, value.x, value.y, value.z);
 }
 
 
@@ -243,7 +391,10 @@ void SGL_Shader::setVector4f(SGL_OpenGLManager &oglm, const GLchar *name, GLfloa
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+    const GLfloat value[4] = {x, y, z, w};
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, value, sizeof(value));
+    if (location != -1)
+        oglm.uniform4f(location, x, y, z, w);
 }
 
 
@@ -260,13 +411,14 @@ void SGL_Shader::setVector4f(SGL_OpenGLManager &oglm, const GLchar *name, glm::v
 {
     if (useShader)
         this->use(oglm);
-    oglm.uniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
-
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform4f(location, value.x, value.y, value.z, value.w);
 }
 
 
 /**
- * @brief Sets a 4D vector
+ * @brief Sets a 4x4 matrix
  * @param oglm The windows OpenGL context
  * @param name Variable to parse
  * @param matrix glm::mat4 to use
@@ -276,9 +428,137 @@ void SGL_Shader::setVector4f(SGL_OpenGLManager &oglm, const GLchar *name, glm::v
  */
 void SGL_Shader::setMatrix4(SGL_OpenGLManager &oglm, const GLchar *name, glm::mat4 matrix, GLboolean useShader) noexcept
 {
-    if(useShader)
+    if (useShader)
+        this->use(oglm);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(name), name, glm::value_ptr(matrix), sizeof(GLfloat) * 16);
+    if (location != -1)
+        oglm.uniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+}
+
+
+/**
+ * @brief Sets a single float default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param value The float value to parse
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setFloat(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat value, GLboolean useShader) noexcept
+{
+    if (useShader)
+        this->use(oglm);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform1f(location, value);
+}
+
+
+/**
+ * @brief Sets a single integer default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param value The integer value to parse
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setInteger(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLint value, GLboolean useShader) noexcept
+{
+    if (useShader)
+        this->use(oglm);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform1i(location, value);
+}
+
+
+/**
+ * @brief Sets a 2D vector default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param x X value
+ * @param y Y value
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setVector2f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat x, GLfloat y, GLboolean useShader) noexcept
+{
+    if (useShader)
+        this->use(oglm);
+    const GLfloat value[2] = {x, y};
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), value, sizeof(value));
+    if (location != -1)
+        oglm.uniform2f(location, x, y);
+}
+
+
+/**
+ * @brief Sets a 4D vector default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param x X value
+ * @param y Y value
+ * @param z Z value
+ * @param w W value
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setVector4f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat x, GLfloat y, GLfloat z, GLfloat w, GLboolean useShader) noexcept
+{
+    if (useShader)
+        this->use(oglm);
+    const GLfloat value[4] = {x, y, z, w};
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), value, sizeof(value));
+    if (location != -1)
+        oglm.uniform4f(location, x, y, z, w);
+}
+
+
+/**
+ * @brief Sets a 4D vector default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param value glm::vec4 to use
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setVector4f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, glm::vec4 value, GLboolean useShader) noexcept
+{
+    if (useShader)
+        this->use(oglm);
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), &value, sizeof(value));
+    if (location != -1)
+        oglm.uniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+
+/**
+ * @brief Sets a 4x4 matrix default uniform
+ * @param oglm The windows OpenGL context
+ * @param uniform Uniform handle
+ * @param matrix glm::mat4 to use
+ * @param useShader Enable the shader?
+ *
+ * @return nothing
+ */
+void SGL_Shader::setMatrix4(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, const glm::mat4 &matrix, GLboolean useShader) noexcept
+{
+    if (useShader)
         this->use(oglm);
-    oglm.uniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, GL_FALSE, glm::value_ptr(matrix));
+    GLint location = this->uploadLocation(oglm, this->uniformIndex(uniform),
+                                          STANDARD_UNIFORM_NAMES[static_cast<int>(uniform)]->c_str(), glm::value_ptr(matrix), sizeof(GLfloat) * 16);
+    if (location != -1)
+        oglm.uniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
 }
 
 
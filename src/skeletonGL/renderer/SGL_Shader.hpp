@@ -26,6 +26,8 @@
 
 // C++
 #include <string>
+#include <vector>
+#include <memory>
 // Dependencies
 #include <GL/glew.h>
 #include "../deps/glm/glm.hpp"
@@ -43,8 +45,39 @@ enum class SHADER_TYPE : std::int8_t { NO_SHADER = 0, SPRITE = 1, SPRITE_BATCH =
     PIXEL_BATCH = 6, LINE = 7, LINE_BATCH = 8, QUAD = 9, POST_PROCESSOR = 10, END_ENUM = 11};
 
 
+/**
+ * @brief Handles to the default uniforms, see the SHADER_UNIFORM_ names in SGL_OGL_CONSTANTS.
+ * Setting one skips the name lookup entirely
+ */
+enum class SHADER_UNIFORM : std::int8_t { COLOR = 0, DELTA_TIME = 1, TIME_ELAPSED = 2, WINDOW_DIMENSIONS = 3, MODEL = 4,
+    PROJECTION = 5, CIRCLE_BORDER_WIDTH = 6, SCENE = 7, FBO_TEXTURE_DIMENSIONS = 8, MOUSE_POSITION = 9, END_ENUM = 10};
+
+/**
+ * @brief An active uniform and the last value uploaded to it
+ */
+struct SGL_UniformSlot
+{
+    std::string name;            ///< Name as declared, without the [0] of arrays
+    GLint location;              ///< Location in the program
+    GLenum type;                 ///< GL_FLOAT_VEC4, GL_FLOAT_MAT4...
+    bool cached;                 ///< Whether value holds what the program has
+    GLfloat value[16];           ///< Raw copy of the last upload, big enough for a mat4
+
+    SGL_UniformSlot() : location(-1), type(0), cached(false) {}
+};
+
+/**
+ * @brief Every active uniform of a linked program, built once after linking
+ */
+struct SGL_UniformTable
+{
+    std::vector<SGL_UniformSlot> slots;
+    std::int16_t standard[static_cast<int>(SHADER_UNIFORM::END_ENUM)]; ///< Slot of each SHADER_UNIFORM, -1 if inactive
+};
+
 /**
  * @brief Extra rendering values to be processed by the shader, note that they must be manually updated!
+ * The default shaders get the time, canvas size and mouse from the SGL_FrameUniforms block instead
  */
 struct RenderDetails
 {
@@ -63,8 +96,23 @@ struct RenderDetails
 class SGL_Shader
 {
 private:
+    // Shaders get copied around by value, every copy of a program shares the same table
+    // so the cached values stay in sync with what the program actually holds
+    std::shared_ptr<SGL_UniformTable> pUniforms;
+
     void checkForErrors(SGL_OpenGLManager &oglm, GLuint object, std::string type);
+    // Queries the active uniforms of the freshly linked program
+    void loadUniforms(SGL_OpenGLManager &oglm);
+    // Table slot of a uniform, UNIFORM_INACTIVE if the program doesn't use it or UNIFORM_UNKNOWN
+    // if the table can't tell (not linked yet, array elements) and the location must be queried
+    std::int16_t uniformIndex(const GLchar *name) const noexcept;
+    std::int16_t uniformIndex(SHADER_UNIFORM uniform) const noexcept;
+    // Stores the new value, returns the location to upload it to or -1 if the program already has it
+    GLint uploadLocation(SGL_OpenGLManager &oglm, std::int16_t index, const GLchar *name, const void *value, std::size_t size) noexcept;
 public:
+    static const std::int16_t UNIFORM_INACTIVE = -1;
+    static const std::int16_t UNIFORM_UNKNOWN = -2;
+
     GLuint ID;                   ///< The shaders internal (OpenGL defined) ID
     SHADER_TYPE shaderType;      ///< What the shader will be used to render
     RenderDetails renderDetails; ///< Extra rendering details
@@ -100,6 +148,17 @@ public:
     void setVector4f(SGL_OpenGLManager &oglm, const GLchar *name, glm::vec4 value, GLboolean useShader = false) noexcept;
     // Set a 4x4 matrix of floats
     void setMatrix4(SGL_OpenGLManager &oglm, const GLchar *name, glm::mat4 matrix, GLboolean useShader = false) noexcept;
+
+    // Same as above for the default uniforms, no string lookups involved
+    void setFloat(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat value, GLboolean useShader = false) noexcept;
+    void setInteger(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLint value, GLboolean useShader = false) noexcept;
+    void setVector2f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat x, GLfloat y, GLboolean useShader = false) noexcept;
+    void setVector4f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, GLfloat x, GLfloat y, GLfloat z, GLfloat w, GLboolean useShader = false) noexcept;
+    void setVector4f(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, glm::vec4 value, GLboolean useShader = false) noexcept;
+    void setMatrix4(SGL_OpenGLManager &oglm, SHADER_UNIFORM uniform, const glm::mat4 &matrix, GLboolean useShader = false) noexcept;
+
+    // Whether the linked program uses one of the default uniforms
+    bool hasUniform(SHADER_UNIFORM uniform) const noexcept;
 };
 
 
@@ -35,7 +35,7 @@
  */
 SGL_Texture::SGL_Texture() :
     width(0), height(0), internalFormat(GL_RGBA8), imageFormat(GL_RGB), wrapS(GL_REPEAT),
-    wrapT(GL_REPEAT), filterMin(GL_LINEAR), filterMax(GL_NEAREST)
+    wrapT(GL_REPEAT), filterMin(GL_LINEAR), filterMax(GL_NEAREST), uvOffset(0.0f), uvScale(0.0f)
 {
 
 }
@@ -63,6 +63,8 @@ void SGL_Texture::generate(SGL_OpenGLManager &oglm, GLuint width, GLuint height,
     oglm.genTextures(1, &this->ID);
     this->width = width;
     this->height = height;
+    this->uvOffset = glm::vec2(0.0f);
+    this->uvScale = glm::vec2(1.0f / width, 1.0f / height);
     // Create texture
     oglm.bindTexture(GL_TEXTURE_2D, this->ID);
     oglm.texImage2D(GL_TEXTURE_2D, 0, this->internalFormat, width, height, 0, this->imageFormat, GL_UNSIGNED_BYTE, data);
@@ -30,6 +30,7 @@
 // Dependencies
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
+#include "../deps/glm/glm.hpp"
 // SkeletonGL
 #include "SGL_OpenGLManager.hpp"
 
@@ -45,6 +46,9 @@ public:
     GLuint internalFormat;                     ///< Texture internal format
     GLuint imageFormat;                        ///< Image file format
     GLuint wrapS, wrapT, filterMin, filterMax; ///< Texture settings
+    // Atlas regions share their page's ID, width and height are the region's own
+    glm::vec2 uvOffset;                        ///< Normalized position of the region in its page, zero for whole textures
+    glm::vec2 uvScale;                         ///< Size of a texel in normalized units
 
     // Constructor
     SGL_Texture();
@@ -58,6 +62,13 @@ public:
     // Activates the texture
     void bind(SGL_OpenGLManager &oglm) const noexcept;
 
+    // Turns a UV coordinate in pixels (as set by SGL_Sprite::changeUVCoords) into the
+    // normalized one OpenGL samples, atlas regions included
+    glm::vec2 normalizeUV(const glm::vec2 &uv) const noexcept
+        {
+            return uvOffset + (uv * uvScale);
+        }
+
 };
 
 #endif // SRC_SKELETONGL_RENDERER_TEXTURE2D_H
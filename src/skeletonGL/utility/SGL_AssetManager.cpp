@@ -28,6 +28,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 // SkeletonGL
 #include "SGL_AssetManager.hpp"
 // STB image
@@ -104,9 +105,10 @@ SGL_Shader SGL_AssetManager::getShader(std::string name) const
  * @param file C string to the image file
  * @param alpha Does thee image have an alpha channel (PNG exclusive, not all PNGs have it though)
  * @param name Name of the final texture
+ * @param atlas Pack it into a shared atlas page instead of giving it its own texture
  * @return SGL_Texture The requested texture
  */
-SGL_Texture SGL_AssetManager::loadTexture(const GLchar *file, GLboolean alpha, std::string name)
+SGL_Texture SGL_AssetManager::loadTexture(const GLchar *file, GLboolean alpha, std::string name, bool atlas)
 {
     if (textures.count(name) > 0)
     {
@@ -116,7 +118,7 @@ SGL_Texture SGL_AssetManager::loadTexture(const GLchar *file, GLboolean alpha, s
     else
     {
         SGL_Log("Generating texture: " + std::string(file), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
-        textures[name] = loadTextureFromFile(file, alpha);
+        textures[name] = atlas ? loadTextureIntoAtlas(file, alpha) : loadTextureFromFile(file, alpha);
         return textures[name];
     }
 }
@@ -266,6 +268,144 @@ SGL_Texture SGL_AssetManager::loadTextureFromFile(const GLchar *file, GLboolean
     return texture;
 }
 
+/**
+ * @brief Loads an image file into a texture atlas page, a new page is created if none has room
+ *
+ * The returned texture is a region handle, it binds the page and carries its position in it
+ * already normalized so the renderer doesn't have to divide every UV by the texture size
+ *
+ * @param file C string to the image file
+ * @param alpha Does the image have an alpha channel?
+ * @return SGL_Texture The region, a standalone texture if it can't fit a page or the default one
+ */
+SGL_Texture SGL_AssetManager::loadTextureIntoAtlas(const GLchar *file, GLboolean alpha)
+{
+    const int pageSize = SGL_OGL_CONSTANTS::ATLAS_PAGE_SIZE, padding = SGL_OGL_CONSTANTS::ATLAS_PADDING;
+
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load(true);
+    // Ask for exactly the channels uploaded below, the pages are always RGBA
+    unsigned char *image = stbi_load(file, &width, &height, &channels, alpha ? 4 : 3);
+    if (image == NULL)
+    {
+        SGL_Log("Texture not found: " + std::string(file));
+        return this->getTexture(SGL::DEFAULT_TEXTURE);
+    }
+    if (width + padding > pageSize || height + padding > pageSize)
+    {
+        SGL_Log("Texture too big for an atlas page, loading it on its own: " + std::string(file), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_YELLOW);
+        stbi_image_free(image);
+        return loadTextureFromFile(file, alpha);
+    }
+
+    // First page with room, padded on the right and top
+    int x = 0, y = 0;
+    std::size_t page = 0;
+    while (page < pAtlasPages.size() && !packRegion(pAtlasPages[page], width + padding, height + padding, x, y))
+        ++page;
+    if (page == pAtlasPages.size())
+    {
+        AtlasPage newPage;
+        newPage.texture.internalFormat = GL_RGBA8;
+        newPage.texture.imageFormat = GL_RGBA;
+        // Regions never wrap, clamping keeps the edges from sampling the other side of the page
+        newPage.texture.wrapS = GL_CLAMP_TO_EDGE;
+        newPage.texture.wrapT = GL_CLAMP_TO_EDGE;
+        // Cleared so the padding between regions is transparent
+        std::vector<unsigned char> blank(pageSize * pageSize * 4, 0);
+        newPage.texture.generate(*WMOGLM, pageSize, pageSize, blank.data());
+        newPage.skyline.push_back(glm::ivec3(0, 0, pageSize));
+        pAtlasPages.push_back(newPage);
+        pTextureGPUMemory += pageSize * pageSize * 4;
+        SGL_Log("Atlas page " + std::to_string(page) + " created | ID: " + std::to_string(newPage.texture.ID), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
+        packRegion(pAtlasPages[page], width + padding, height + padding, x, y);
+    }
+
+    const SGL_Texture &pageTexture = pAtlasPages[page].texture;
+    WMOGLM->bindTexture(GL_TEXTURE_2D, pageTexture.ID);
+    // stb_image rows are tightly packed, RGB ones aren't necessarily 4 byte aligned
+    WMOGLM->pixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    WMOGLM->texSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, alpha ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, image);
+    WMOGLM->bindTexture(GL_TEXTURE_2D, 0);
+    stbi_image_free(image);
+
+    // The region, stb_image flipped the image so its first row sits at y like OpenGL expects
+    SGL_Texture region = pageTexture;
+    region.width = width;
+    region.height = height;
+    region.uvOffset = glm::vec2(x, y) * pageTexture.uvScale;
+    SGL_Log("| Atlas page: " + std::to_string(page) + " | X: " + std::to_string(x) + " Y: " + std::to_string(y) +
+            " | W: " + std::to_string(width) + " H: " + std::to_string(height) + " |", LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
+    return region;
+}
+
+/**
+ * @brief Finds the lowest spot in an atlas page a region fits in and claims it
+ *
+ * Skyline bottom left packing, the region rests on the tallest segment under it and the
+ * lowest such spot wins, ties go to the narrowest segment to leave wider gaps open
+ *
+ * @param page Atlas page to pack the region into
+ * @param width Region width
+ * @param height Region height
+ * @param x Region position if it fits
+ * @param y Region position if it fits
+ * @return bool False if the page doesn't have room
+ */
+bool SGL_AssetManager::packRegion(AtlasPage &page, int width, int height, int &x, int &y)
+{
+    const int pageSize = SGL_OGL_CONSTANTS::ATLAS_PAGE_SIZE;
+    std::vector<glm::ivec3> &skyline = page.skyline;
+
+    int best = -1, bestY = pageSize, bestWidth = pageSize;
+    for (std::size_t i = 0; i < skyline.size() && skyline[i].x + width <= pageSize; ++i)
+    {
+        int top = 0;
+        for (std::size_t j = i, covered = 0; covered < static_cast<std::size_t>(width); covered += skyline[j].z, ++j)
+            top = std::max(top, skyline[j].y);
+        if (top + height > pageSize)
+            continue;
+        if (top < bestY || (top == bestY && skyline[i].z < bestWidth))
+        {
+            best = static_cast<int>(i);
+            bestY = top;
+            bestWidth = skyline[i].z;
+        }
+    }
+    if (best < 0)
+        return false;
+
+    x = skyline[best].x;
+    y = bestY;
+    // The region's top becomes a new segment, trim or drop the ones it covers
+    skyline.insert(skyline.begin() + best, glm::ivec3(x, y + height, width));
+    for (std::size_t i = best + 1; i < skyline.size();)
+    {
+        int overlap = (x + width) - skyline[i].x;
+        if (overlap <= 0)
+            break;
+        if (overlap < skyline[i].z)
+        {
+            skyline[i].x += overlap;
+            skyline[i].z -= overlap;
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+    // Merge neighbours left at the same height
+    for (std::size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].z += skyline[i + 1].z;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            ++i;
+    }
+    return true;
+}
+
 /**
  * @brief Return the total GPU memory allocated by SGL
  * @return int Total memory in bytes
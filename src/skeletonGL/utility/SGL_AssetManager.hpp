@@ -48,10 +48,24 @@ private:
     std::map<std::string, SGL_Texture> textures;                  ///< Map of all available textures
     std::uint64_t pTextureGPUMemory;                              ///< How much GPU memory the program is using
 
+    // Texture atlas, small images share pages so the sprites using them can be drawn together.
+    // Each page is packed with a skyline, the top edge of what's been placed so far stored as
+    // x, y and width segments from left to right
+    struct AtlasPage
+    {
+        SGL_Texture texture;
+        std::vector<glm::ivec3> skyline;
+    };
+    std::vector<AtlasPage> pAtlasPages;
+
     // Parses, compiles and links a shader, geometry shader is optional
     SGL_Shader loadShaderFromFile(SHADER_TYPE shaderType, const GLchar *vertexSource, const GLchar *fragmentSource, const GLchar *geometrySource = nullptr);
     // Creates an OpenGL texture from a supported image
     SGL_Texture loadTextureFromFile(const GLchar *file, GLboolean alpha);
+    // Same as above but packed into an atlas page, returns the region
+    SGL_Texture loadTextureIntoAtlas(const GLchar *file, GLboolean alpha);
+    // Finds room for a width x height region in a page, false if it's full
+    bool packRegion(AtlasPage &page, int width, int height, int &x, int &y);
 
 public:
     // Constructor
@@ -62,7 +76,9 @@ public:
     //loads and generates a shader program from a source file
     SGL_Shader loadShaders(const GLchar *vertexSource, const GLchar *fragmentSource, const GLchar *geometrySource, std::string name, SHADER_TYPE shaderType);
     //loads and generates a texture from a file, throws SGL_Exception if shit happens
-    SGL_Texture loadTexture(const GLchar *file, GLboolean alpha, std::string name);
+    // Atlas textures are regions of a shared page, meant for sprite sheets and UI bits
+    // drawn together. They can't wrap or repeat past their edges
+    SGL_Texture loadTexture(const GLchar *file, GLboolean alpha, std::string name, bool atlas = false);
 
     // Finds and retrieves a stored shader, throws on error (can't render without a shader)
     // Note that these const functions used to return map[key] instead of map.at(key) and thus
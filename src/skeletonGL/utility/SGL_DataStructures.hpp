@@ -57,6 +57,7 @@ namespace SGL
 
     const std::string DEFAULT_SPRITE_SHADER       = "default_sprite_shader";
     const std::string DEFAULT_SPRITE_BATCH_SHADER = "default_sprite_batch_shader";
+    const std::string DEFAULT_SPRITE_QUEUE_SHADER = "default_sprite_queue_shader";
     const std::string DEFAULT_PIXEL_SHADER        = "default_pixel_shader";
     const std::string DEFAULT_PIXEL_BATCH_SHADER  = "default_pixel_batch_shader";
     const std::string DEFAULT_TEXT_SHADER         = "default_text_shader";
@@ -89,6 +90,21 @@ namespace SGL_OGL_CONSTANTS
     const std::uint32_t MAX_PIXEL_BATCH_INSTANCES = 10000;
     const std::uint32_t MAX_LINE_BATCH_INSTANCES = 10000;
 
+    // Side of a texture atlas page and the empty gap left between packed images so
+    // filtering doesn't bleed one into the next
+    const int ATLAS_PAGE_SIZE = 1024;
+    const int ATLAS_PADDING = 1;
+
+    // Texture units the OpenGL manager keeps track of, GL_TEXTURE0 onwards
+    const std::uint32_t MAX_TEXTURE_UNITS = 16;
+    // Uniform buffer binding points the OpenGL manager keeps track of
+    const std::uint32_t MAX_UNIFORM_BUFFER_BINDINGS = 8;
+
+    // Per frame uniform block every shader can declare, see SGL_FrameUniforms
+    const GLuint FRAME_UNIFORMS_BINDING = 0;
+    const std::string FRAME_UNIFORMS_BLOCK = "SGL_FrameUniforms";
+    const std::string SGL_WINDOW_FRAME_UBO = "SGL_Window_frame_UBO";
+
     // Names assigned to the OpenGL objects used by the SGL_Renderer
     const std::string SGL_RENDERER_PIXEL_VAO                  = "SGL_Renderer_pixel_VAO";
     const std::string SGL_RENDERER_PIXEL_VBO                  = "SGL_Renderer_pixel_VBO";
@@ -105,6 +121,9 @@ namespace SGL_OGL_CONSTANTS
     const std::string SGL_RENDERER_SPRITE_BATCH_INSTANCES_VBO = "SGL_Renderer_sprite_batch_instances_VBO";
     const std::string SGL_RENDERER_SPRITE_BATCH_VAO           = "SGL_Renderer_sprite_batch_VAO";
     const std::string SGL_RENDERER_SPRITE_BATCH_VBO           = "SGL_Renderer_sprite_batch_VBO";
+    const std::string SGL_RENDERER_SPRITE_QUEUE_INSTANCES_VBO = "SGL_Renderer_sprite_queue_instances_VBO";
+    const std::string SGL_RENDERER_SPRITE_QUEUE_VAO           = "SGL_Renderer_sprite_queue_VAO";
+    const std::string SGL_RENDERER_SPRITE_QUEUE_VBO           = "SGL_Renderer_sprite_queue_VBO";
     const std::string SGL_RENDERER_TEXT_VAO                   = "SGL_Renderer_text_VAO";
     const std::string SGL_RENDERER_TEXT_VBO                   = "SGL_Renderer_text_VBO";
     const std::string SGL_RENDERER_TEXTURE_UV_VBO             = "SGL_Renderer_texture_uv_VBO";
@@ -158,6 +177,8 @@ namespace FOLDER_STRUCTURE
     const std::string SPRITE_SHADER_F_FILE       = FOLDER_STRUCTURE::SHADERS_DIR + "spriteF.c";
     const std::string SPRITE_BATCH_SHADER_V_FILE = FOLDER_STRUCTURE::SHADERS_DIR + "spriteBatchV.c";
     const std::string SPRITE_BATCH_SHADER_F_FILE = FOLDER_STRUCTURE::SHADERS_DIR + "spriteBatchF.c";
+    const std::string SPRITE_QUEUE_SHADER_V_FILE = FOLDER_STRUCTURE::SHADERS_DIR + "spriteQueueV.c";
+    const std::string SPRITE_QUEUE_SHADER_F_FILE = FOLDER_STRUCTURE::SHADERS_DIR + "spriteQueueF.c";
     const std::string PIXEL_SHADER_V_FILE        = FOLDER_STRUCTURE::SHADERS_DIR + "pixelV.c";
     const std::string PIXEL_SHADER_F_FILE        = FOLDER_STRUCTURE::SHADERS_DIR + "pixelF.c";
     const std::string PIXEL_BATCH_SHADER_V_FILE  = FOLDER_STRUCTURE::SHADERS_DIR + "pixelBatchV.c";
@@ -314,6 +335,35 @@ struct SGL_IniField
     std::string title, key, value;
 };
 
+/**
+ * @brief CPU side copy of the SGL_FrameUniforms block, laid out following the std140 rules.
+ * The shaders declare it as:
+ *
+ *     layout (std140) uniform SGL_FrameUniforms
+ *     {
+ *         mat4 projection;        // Camera or overlay, whichever mode is active
+ *         mat4 overlayProjection;
+ *         vec2 canvasSize;        // Internal resolution
+ *         vec2 mousePosition;     // In internal resolution pixels
+ *         float timeElapsed;      // Seconds since the window was created
+ *         float deltaTime;        // Last frame's duration in seconds
+ *     };
+ */
+struct SGL_FrameUniforms
+{
+    glm::mat4 projection;
+    glm::mat4 overlayProjection;
+    glm::vec2 canvasSize;
+    glm::vec2 mousePosition;
+    float timeElapsed;
+    float deltaTime;
+    float padding[2];            ///< std140 rounds the block up to a multiple of 16 bytes
+
+    SGL_FrameUniforms() : projection(1.0f), overlayProjection(1.0f), canvasSize(0.0f), mousePosition(0.0f),
+                          timeElapsed(0.0f), deltaTime(0.0f), padding{0.0f, 0.0f} {}
+};
+static_assert(sizeof(SGL_FrameUniforms) == 160, "SGL_FrameUniforms must match the std140 layout");
+
 /**
  * @brief Contains an individual frame's time data
  */
@@ -371,6 +421,15 @@ struct CurrentSettings
     GLSetting depth, faceCulling, blending, depthMask;
 };
 
+/**
+ * @brief State changing OpenGL calls that reached the driver vs the ones dropped as redundant
+ */
+struct GLStateCounters
+{
+    std::uint64_t issued, elided;
+    GLStateCounters() : issued(0), elided(0) {}
+};
+
 
 /**
  * @brief Helps with priority sorting
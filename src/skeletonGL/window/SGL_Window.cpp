@@ -462,6 +462,8 @@ void SGL_Window::start()
     // Initialize the camera module (required for the projection matrix that be will parsed to the shaders)
     this->pCamera = new SGL_Camera(pOGLM);
     this->pCamera->initialize(getWindowCreationSpecs().internalW, getWindowCreationSpecs().internalH);
+    // The projections and timers reach the shaders through a shared uniform block
+    this->startFrameUniforms();
     // Update orthographic shaders
     this->setCameraMode(CAMERA_MODE::DEFAULT);
     SGL_Log("Orthographic shader width: " + std::to_string(this->getWindowCreationSpecs().internalW), LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
@@ -480,6 +482,7 @@ void SGL_Window::start()
                                               assetManager->getShader(SGL::DEFAULT_CIRCLE_BATCH_SHADER),
                                               assetManager->getShader(SGL::DEFAULT_SPRITE_SHADER),
                                               assetManager->getShader(SGL::DEFAULT_SPRITE_BATCH_SHADER),
+                                              assetManager->getShader(SGL::DEFAULT_SPRITE_QUEUE_SHADER),
                                               assetManager->getShader(SGL::DEFAULT_TEXT_SHADER));
 
     SGL_Log("Renderer configured.", LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
@@ -582,14 +585,27 @@ void SGL_Window::setLogLevel(LOG_LEVEL logLevel)
  */
 void SGL_Window::setCameraMode(CAMERA_MODE mode)
 {
-    /*  Camera is active, apply the offset to the projection matrix */
-    // Attempt to iterate all the required shaders, the PP doesn't require any MVP transformations
-    // since it simply blits the final FBO texture to the screen
+    // Queued sprites were submitted with the current projection, draw them before it changes
+    if (renderer)
+        renderer->flush();
+
+    // The camera moved since the frame started, the block needs the new matrices
+    if (pFrameUniforms.projection != this->pCamera->getCameraMatrix() ||
+        pFrameUniforms.overlayProjection != this->pCamera->getOverlayMatrix())
+        this->updateFrameUniforms();
+
+    // Both modes are already in the buffer, switching is just pointing the binding at the other copy
+    pOGLM->bindUBORange(SGL_OGL_CONSTANTS::SGL_WINDOW_FRAME_UBO, SGL_OGL_CONSTANTS::FRAME_UNIFORMS_BINDING,
+                        (mode == CAMERA_MODE::OVERLAY) ? pFrameUniformsStride : 0, sizeof(SGL_FrameUniforms));
+
+    // Shaders that still declare a plain projection uniform get it pushed one by one, the PP
+    // doesn't require any MVP transformations since it simply blits the final FBO texture to the screen
     for (auto iter = assetManager->shaderTypes.begin(); iter != assetManager->shaderTypes.end(); ++iter)
     {
-        if (assetManager->getShader((*iter).first).shaderType != SHADER_TYPE::POST_PROCESSOR)
+        SGL_Shader shader = assetManager->getShader((*iter).first);
+        if (shader.shaderType != SHADER_TYPE::POST_PROCESSOR && shader.hasUniform(SHADER_UNIFORM::PROJECTION))
         {
-            this->pCamera->cameraMode(assetManager->getShader((*iter).first), mode);
+            this->pCamera->cameraMode(shader, mode);
             //SGL_Log("Updating shader: " + (*iter).first);
         }
     }
@@ -635,6 +651,25 @@ int SGL_Window::getCameraPosH() const
     return static_cast<int>(this->pCamera->getPosition().w);
 }
 
+/**
+ * @brief Maps a screen point to world coordinates through the inverse camera transform
+ * @param screen Point in internal resolution pixels
+ * @return glm::vec2 World position under the point
+ */
+glm::vec2 SGL_Window::screenToWorld(glm::vec2 screen) const
+{
+    return this->pCamera->screenToWorld(screen);
+}
+
+/**
+ * @brief Returns the world area visible through the camera
+ * @return glm::vec4 Visible area (x, y, w, h)
+ */
+glm::vec4 SGL_Window::getCameraViewport() const
+{
+    return this->pCamera->getViewport();
+}
+
 /**
  * @brief Set the OpenGL clear screen color
  * @param color The new clear screen color (alpha is ignored)
@@ -1019,6 +1054,52 @@ void SGL_Window::startFBO(const SGL_Shader &shader)
 }
 
 
+/**
+ * @brief Allocates the per frame uniform buffer, room for the block twice: once with the camera
+ * projection and once with the overlay one
+ * @return nothing
+ */
+void SGL_Window::startFrameUniforms()
+{
+    GLint alignment = 1;
+    pOGLM->getIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment = std::max(alignment, 1);
+    GLsizeiptr blockSize = sizeof(SGL_FrameUniforms);
+    pFrameUniformsStride = ((blockSize + alignment - 1) / alignment) * alignment;
+    pFrameUniformsStaging.assign(pFrameUniformsStride * 2, 0);
+
+    pOGLM->createUBO(SGL_OGL_CONSTANTS::SGL_WINDOW_FRAME_UBO);
+    pOGLM->bindUBO(SGL_OGL_CONSTANTS::SGL_WINDOW_FRAME_UBO);
+    pOGLM->bufferData(GL_UNIFORM_BUFFER, pFrameUniformsStaging.size(), nullptr, GL_DYNAMIC_DRAW);
+
+    pStartTime = std::chrono::steady_clock::now();
+    pDeltaTimeMS = 0.0f;
+    this->updateFrameUniforms();
+}
+
+/**
+ * @brief Refreshes the per frame uniform block and uploads both camera mode copies with a single write
+ * @return nothing
+ */
+void SGL_Window::updateFrameUniforms()
+{
+    pFrameUniforms.projection = this->pCamera->getCameraMatrix();
+    pFrameUniforms.overlayProjection = this->pCamera->getOverlayMatrix();
+    pFrameUniforms.canvasSize = glm::vec2(pWindowCreationSpecs.internalW, pWindowCreationSpecs.internalH);
+    pFrameUniforms.mousePosition = glm::vec2(pDeltaInput.mouse.cursorXNormalized, pDeltaInput.mouse.cursorYNormalized);
+    pFrameUniforms.timeElapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - pStartTime).count();
+    pFrameUniforms.deltaTime = static_cast<float>(pDeltaTimeMS);
+
+    SGL_FrameUniforms overlay = pFrameUniforms;
+    overlay.projection = overlay.overlayProjection;
+    std::memcpy(&pFrameUniformsStaging[0], &pFrameUniforms, sizeof(SGL_FrameUniforms));
+    std::memcpy(&pFrameUniformsStaging[pFrameUniformsStride], &overlay, sizeof(SGL_FrameUniforms));
+
+    pOGLM->bindUBO(SGL_OGL_CONSTANTS::SGL_WINDOW_FRAME_UBO);
+    pOGLM->bufferSubData(GL_UNIFORM_BUFFER, 0, pFrameUniformsStaging.size(), pFrameUniformsStaging.data());
+}
+
+
 /**
  * @brief Take an initial timestamp of the frame to be processed and reload the post processor
  * @return nothing
@@ -1029,6 +1110,8 @@ void SGL_Window::startFrame()
     // pChrono0 = std::chrono::high_resolution_clock::now();
     pChrono0 = std::chrono::steady_clock::now();
 
+    // One write for everything the shaders need this frame
+    this->updateFrameUniforms();
 
     // Begin FBO operations
     this->pPostProcessorFBO->beginRender();
@@ -1042,6 +1125,7 @@ void SGL_Window::startFrame()
 void SGL_Window::endFrame()
 {
     // End all rendering operations
+    this->renderer->endFrame();
     this->pPostProcessorFBO->endRender();
 
     // pChrono1 = std::chrono::high_resolution_clock::now();
@@ -1132,8 +1216,9 @@ void SGL_Window::pLoadDefaultAssets()
 
     assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_TEXTURE_FILE.c_str(), GL_FALSE, SGL::DEFAULT_TEXTURE);
     assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_INVISIBLE_TEXTURE_FILE.c_str(), GL_TRUE, SGL::INVISIBLE_TEXTURE);
-    assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_SQUARE_TEXTURE_FILE.c_str(), GL_TRUE, SGL::SQUARE_TEXTURE);
-    assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_BMP_FONT_TEXTURE_FILE.c_str(), GL_TRUE, SGL::DEFAULT_BMP_FONT_TEXTURE);
+    // Share an atlas page with the UI so text and panels can be drawn in the same batch
+    assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_SQUARE_TEXTURE_FILE.c_str(), GL_TRUE, SGL::SQUARE_TEXTURE, true);
+    assetManager->loadTexture(FOLDER_STRUCTURE::DEFAULT_BMP_FONT_TEXTURE_FILE.c_str(), GL_TRUE, SGL::DEFAULT_BMP_FONT_TEXTURE, true);
 
     SGL_Log("Default textures loaded.", LOG_LEVEL::SGL_DEBUG, LOG_COLOR::TERM_DEFAULT);
 
@@ -1205,6 +1290,10 @@ void SGL_Window::pLoadDefaultAssets()
     assetManager->loadShaders(FOLDER_STRUCTURE::SPRITE_BATCH_SHADER_V_FILE.c_str(),
                               FOLDER_STRUCTURE::SPRITE_BATCH_SHADER_F_FILE.c_str(),
                               nullptr, SGL::DEFAULT_SPRITE_BATCH_SHADER, SHADER_TYPE::SPRITE_BATCH);
+    // Instanced sprite shader the renderer's deferred queue is drawn with
+    assetManager->loadShaders(FOLDER_STRUCTURE::SPRITE_QUEUE_SHADER_V_FILE.c_str(),
+                              FOLDER_STRUCTURE::SPRITE_QUEUE_SHADER_F_FILE.c_str(),
+                              nullptr, SGL::DEFAULT_SPRITE_QUEUE_SHADER, SHADER_TYPE::SPRITE_BATCH);
     assetManager->loadShaders(FOLDER_STRUCTURE::TEXT_SHADER_V_FILE.c_str(),
                               FOLDER_STRUCTURE::TEXT_SHADER_F_FILE.c_str(),
                               nullptr, SGL::DEFAULT_TEXT_SHADER, SHADER_TYPE::TEXT);
@@ -34,6 +34,7 @@
 #include <stdio.h>
 #include <thread>
 #include <chrono>
+#include <cstring>
 
 // GLEW
 #define GLEW_STATIC
@@ -103,6 +104,11 @@ private:
     //FBO and shader to reload the FBO if necessary
     SGL_PostProcessor *pPostProcessorFBO;                     ///< Main framebuffer
     SGL_Shader pDefaultPPShader;                              ///< Main post-processor shader
+    // PER FRAME UNIFORM BLOCK
+    SGL_FrameUniforms pFrameUniforms;                         ///< Last uploaded block, projection as in the DEFAULT camera mode
+    std::vector<std::uint8_t> pFrameUniformsStaging;          ///< DEFAULT and OVERLAY copies of the block, uploaded together
+    GLsizeiptr pFrameUniformsStride;                          ///< Offset of the OVERLAY copy, honors the UBO offset alignment
+    std::chrono::steady_clock::time_point pStartTime;         ///< Start of the timeElapsed count
 
     // TESTING
     SDL_Joystick *pGamepad_1;
@@ -115,6 +121,10 @@ private:
     void startFBO(const SGL_Shader &shader);
     // Resize the OGL viewport and resize the PP-FBO texture to match.
     void resizeGL(int width, int heigth);
+    // Creates the per frame uniform buffer
+    void startFrameUniforms();
+    // Writes the per frame uniform block, one buffer update for both camera modes
+    void updateFrameUniforms();
     // Processes the .ini file (must be located in the same folder as the executable)
     void processIniFile(std::string path);
 
@@ -187,6 +197,10 @@ public:
     int getCameraPosW() const;
     // Get the camera's height
     int getCameraPosH() const;
+    // Maps a point in internal resolution pixels (see cursorXNormalized) to world coordinates
+    glm::vec2 screenToWorld(glm::vec2 screen) const;
+    // Get the world area in view (x, y, w, h)
+    glm::vec4 getCameraViewport() const;
 
     // -- INPUT --
     // Returns a COPY of the this frame's total input
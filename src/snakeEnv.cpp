@@ -0,0 +1,142 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <exception>
+#include <memory>
+#include <vector>
+#include "snakeEnv.h"
+#include "batchSimulation.hpp"
+#include "observation.hpp"
+
+struct SnakeEnv
+{
+    BatchSimulation batch;
+    std::vector<DIRECTION> dirs;
+    std::vector<COLLISION> results;
+    std::vector<std::uint8_t> done;
+    std::uint32_t tiles;
+    std::unique_ptr<ObservationRasterizer> planes;
+
+    SnakeEnv(std::uint32_t envs, std::uint16_t width, std::uint16_t height)
+        : batch(envs, width, height), dirs(envs), results(envs), done(envs, 0),
+          tiles(static_cast<std::uint32_t>(width) * height), planes(new ObservationRasterizer(batch)) {}
+};
+
+// Nothing may throw past the C interface, a failed create is the only error it can report
+SnakeEnv *snake_env_create(uint32_t envs, uint16_t width, uint16_t height)
+{
+    if (envs == 0)
+        return nullptr;
+    try
+    {
+        return new SnakeEnv(envs, width, height);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+void snake_env_destroy(SnakeEnv *env)
+{
+    delete env;
+}
+
+uint32_t snake_env_count(const SnakeEnv *env)
+{
+    return env->batch.getGames();
+}
+
+uint32_t snake_env_observation_size(const SnakeEnv *env)
+{
+    return env->tiles;
+}
+
+void snake_env_reset(SnakeEnv *env, uint32_t first_seed, uint8_t *observations)
+{
+    for (std::uint32_t i = 0; i < env->batch.getGames(); ++i)
+        snake_env_reset_one(env, i, first_seed + i, observations);
+}
+
+int snake_env_reset_one(SnakeEnv *env, uint32_t index, uint32_t seed, uint8_t *observations)
+{
+    if (index >= env->batch.getGames())
+        return -1;
+    env->batch.reset(index, seed);
+    env->done[index] = 0;
+    if (observations)
+        env->batch.writeObservation(index, observations + (static_cast<std::size_t>(index) * env->tiles));
+    return 0;
+}
+
+void snake_env_step(SnakeEnv *env, const int8_t *actions, uint8_t *observations, float *rewards, uint8_t *dones)
+{
+    std::uint32_t envs = env->batch.getGames();
+    for (std::uint32_t i = 0; i < envs; ++i)
+        env->dirs[i] = (actions[i] >= 0 && actions[i] < static_cast<int8_t>(DIRECTION::NO_DIRECTION))
+                           ? static_cast<DIRECTION>(actions[i]) : DIRECTION::NO_DIRECTION;
+    env->batch.step(env->dirs.data(), env->results.data());
+
+    for (std::uint32_t i = 0; i < envs; ++i)
+    {
+        float reward = 0.0f;
+        if (env->results[i] == COLLISION::FOOD)
+            reward = 1.0f;
+        else if (env->results[i] == COLLISION::SNAKE && !env->done[i])
+        {
+            // Only the step that killed the snake is penalized
+            reward = -1.0f;
+            env->done[i] = 1;
+        }
+        if (rewards)
+            rewards[i] = reward;
+        if (dones)
+            dones[i] = env->done[i];
+        if (observations)
+            env->batch.writeObservation(i, observations + (static_cast<std::size_t>(i) * env->tiles));
+    }
+}
+
+uint32_t snake_env_score(const SnakeEnv *env, uint32_t index)
+{
+    return (index < env->batch.getGames()) ? env->batch.getScore(index) : 0;
+}
+
+uint32_t snake_env_planes_size(const SnakeEnv *env)
+{
+    return static_cast<uint32_t>(env->planes->getObservationSize());
+}
+
+int snake_env_set_plane_threads(SnakeEnv *env, uint32_t threads)
+{
+    // The old rasterizer stays in place unless the new one is fully built
+    std::unique_ptr<ObservationRasterizer> planes;
+    try
+    {
+        planes.reset(new ObservationRasterizer(env->batch, threads));
+    }
+    catch (const std::exception &)
+    {
+        return -1;
+    }
+    env->planes.swap(planes);
+    return 0;
+}
+
+void snake_env_planes_u8(SnakeEnv *env, uint8_t *planes)
+{
+    env->planes->rasterize(planes);
+}
+
+void snake_env_planes_f32(SnakeEnv *env, float *planes)
+{
+    env->planes->rasterize(planes);
+}
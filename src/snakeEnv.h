@@ -0,0 +1,73 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef SNAKE_ENV_H
+#define SNAKE_ENV_H
+
+#include <stdint.h>
+
+/* Batched environments for reinforcement learning, a plain C interface over
+ * BatchSimulation so it can be loaded from Python (ctypes / cffi) or anything else
+ * that speaks C. Built as libsnake-env.so by `make env`, no window or OpenGL needed.
+ *
+ * The rules are the game's: walls stop the snake, moving into the neck is ignored,
+ * the rest of the body ends the episode. Every call writes straight into buffers
+ * owned by the caller, laid out env after env with no padding:
+ *
+ *   observations  envs * snake_env_observation_size() bytes, one CELL tag per tile
+ *                 (0 empty, 1 head, 2 neck, 3 body, 4 food), row major
+ *   rewards       envs floats, +1 for eating, -1 for dying, 0 otherwise
+ *   dones         envs bytes, 1 from the step the snake died on until the env is reset
+ *   actions       envs int8_t, 0 up, 1 down, 2 left, 3 right, anything else waits
+ *
+ * An env isn't thread safe, different envs can be stepped from different threads */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SnakeEnv SnakeEnv;
+
+/* Returns NULL if the board is invalid (up to 65535 tiles) or out of memory */
+SnakeEnv *snake_env_create(uint32_t envs, uint16_t width, uint16_t height);
+void snake_env_destroy(SnakeEnv *env);
+
+uint32_t snake_env_count(const SnakeEnv *env);
+/* Bytes of observation per env */
+uint32_t snake_env_observation_size(const SnakeEnv *env);
+
+/* Env i is seeded with first_seed + i, observations can be NULL */
+void snake_env_reset(SnakeEnv *env, uint32_t first_seed, uint8_t *observations);
+/* Resets a single env, its observation is written to its own slice of observations
+ * (which still points to the whole batch). Returns 0, or -1 if index is out of range */
+int snake_env_reset_one(SnakeEnv *env, uint32_t index, uint32_t seed, uint8_t *observations);
+/* One move for every env, any output pointer can be NULL */
+void snake_env_step(SnakeEnv *env, const int8_t *actions, uint8_t *observations, float *rewards, uint8_t *dones);
+
+/* Score of an env, the same Grid::getScore() reports */
+uint32_t snake_env_score(const SnakeEnv *env, uint32_t index);
+
+/* Stacked planes for every env instead of the CELL tags (see ObservationRasterizer):
+ * head, body valued by the moves each segment has left, food, then one plane per direction
+ * (up, down, left, right) marking the tiles where moving that way runs into the edge.
+ * uint8 planes go from 0 to 255 and float ones from 0 to 1, planes_size values per env */
+uint32_t snake_env_planes_size(const SnakeEnv *env);
+/* Threads (the caller's included) splitting the envs between them, 1 by default.
+ * Returns 0, or -1 if they can't be started and the previous setting stays */
+int snake_env_set_plane_threads(SnakeEnv *env, uint32_t threads);
+void snake_env_planes_u8(SnakeEnv *env, uint8_t *planes);
+void snake_env_planes_f32(SnakeEnv *env, float *planes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,73 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.hpp"
+
+bool saveSnapshot(const Simulation &sim, const std::string &path)
+{
+    std::string temporary = path + ".tmp";
+    std::size_t size = sim.getSnapshotSize();
+
+    int file = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0)
+        return false;
+    if (ftruncate(file, size) != 0)
+    {
+        close(file);
+        return false;
+    }
+    void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (map == MAP_FAILED)
+    {
+        close(file);
+        return false;
+    }
+
+    sim.writeSnapshot(map);
+    // The new contents have to reach the disk before the rename does, or a crash
+    // could leave path pointing at a file that was never written out
+    bool flushed = (msync(map, size, MS_SYNC) == 0);
+    munmap(map, size);
+    flushed = (fsync(file) == 0) && flushed;
+    close(file);
+    if (!flushed)
+        return false;
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool loadSnapshot(Simulation &sim, const std::string &path)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size <= 0)
+    {
+        close(file);
+        return false;
+    }
+    std::size_t size = info.st_size;
+    void *map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (map == MAP_FAILED)
+        return false;
+
+    // The header's food count decides the layout. A file could be corrupted or from
+    // anywhere, so it's checked in full before the game takes any of it
+    bool loaded = sim.verifySnapshot(map, size) && sim.readSnapshot(map, size);
+    munmap(map, size);
+    return loaded;
+}
@@ -0,0 +1,27 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <string>
+#include "simulation.hpp"
+
+// Snapshot files, a SimulationSnapshot as is. Both ends map the file instead of
+// reading it, so saving or restoring a game costs about as much as copying it
+
+// Writes next to path and renames over it once done, a crash mid save leaves the
+// previous snapshot intact. Returns false if the file can't be written
+bool saveSnapshot(const Simulation &sim, const std::string &path);
+// Returns false if the file is missing, truncated, inconsistent or was saved for another board
+bool loadSnapshot(Simulation &sim, const std::string &path);
+
+#endif
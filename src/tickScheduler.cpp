@@ -0,0 +1,66 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#include <cmath>
+#include <stdexcept>
+#include "tickScheduler.hpp"
+
+TickScheduler::TickScheduler(std::uint64_t timeBase, std::uint32_t rate, std::uint32_t maxTicks)
+{
+    if (timeBase == 0)
+        throw std::invalid_argument("TickScheduler::TickScheduler | The time base must be above 0");
+
+    pTimeBase = timeBase;
+    pRate = rate;
+    pMaxTicks = (maxTicks == 0) ? 1 : maxTicks;
+    pAccumulator = 0;
+}
+
+std::uint32_t TickScheduler::advance(std::uint64_t time)
+{
+    // One tick per pTimeBase * ONE, exact as long as the product fits in 64 bits
+    std::uint64_t period = pTimeBase * ONE;
+    pAccumulator += time * pRate;
+
+    std::uint64_t due = pAccumulator / period;
+    std::uint32_t ticks = (due > pMaxTicks) ? pMaxTicks : static_cast<std::uint32_t>(due);
+    pAccumulator -= ticks * period;
+    return ticks;
+}
+
+void TickScheduler::reset()
+{
+    pAccumulator = 0;
+}
+
+void TickScheduler::setRate(std::uint32_t rate)
+{
+    // Progress towards the next tick is kept, the new rate applies from here on
+    pRate = rate;
+}
+
+std::uint32_t TickScheduler::getRate() const
+{
+    return pRate;
+}
+
+std::uint32_t TickScheduler::toFixed(double ticksPerSecond)
+{
+    if (!(ticksPerSecond > 0.0))
+        return 0;
+    double fixed = std::round(ticksPerSecond * ONE);
+    return (fixed >= 4294967295.0) ? 0xFFFFFFFF : static_cast<std::uint32_t>(fixed);
+}
+
+double TickScheduler::fromFixed(std::uint32_t rate)
+{
+    return static_cast<double>(rate) / ONE;
+}
@@ -0,0 +1,49 @@
+// ╔═╗╦╔═╔═╗╦  ╔═╗╔╦╗╔═╗╔╗╔╔═╗╦
+// ╚═╗╠╩╗║╣ ║  ║╣  ║ ║ ║║║║║ ╦║
+// ╚═╝╩ ╩╚═╝╩═╝╚═╝ ╩ ╚═╝╝╚╝╚═╝╩═╝
+// ─┐ ┬┌─┐┌┐┌┌─┐┌┐ ┬ ┬┌┬┐┌─┐ ─┐ ┬┬ ┬┌─┐
+// ┌┴┬┘├┤ ││││ │├┴┐└┬┘ │ ├┤  ┌┴┬┘└┬┘┌─┘
+// ┴ └─└─┘┘└┘└─┘└─┘ ┴  ┴ └─┘o┴ └─ ┴ └─┘
+// Author:  SENEX @ XENOBYTE.XYZ
+// License: MIT License
+// Website: https://xenobyte.xyz/projects/?nav=snake-sgl
+
+
+#ifndef TICK_SCHEDULER_HPP
+#define TICK_SCHEDULER_HPP
+
+#include <cstdint>
+
+// Turns elapsed time into game ticks at any rate, several per update included.
+// Time and rate are integers (the rate in 16.16 fixed point) and the remainder is
+// carried over, so the same total time always yields the same ticks no matter how
+// it was split into updates
+class TickScheduler
+{
+private:
+    std::uint64_t pTimeBase;    // Time units per second
+    std::uint32_t pRate;        // Ticks per second, 16.16 fixed point
+    std::uint64_t pAccumulator; // Elapsed time times rate, a tick every pTimeBase * ONE
+    std::uint32_t pMaxTicks;
+
+public:
+    static const std::uint32_t ONE = 1 << 16;
+
+    // Elapsed time is measured in 1 / timeBase seconds, timeBase must be above 0.
+    // maxTicks caps a single advance(), ticks beyond it are played on the next ones. A rate
+    // above maxTicks per time unit can never catch up, callers should keep under it
+    TickScheduler(std::uint64_t timeBase, std::uint32_t rate, std::uint32_t maxTicks = 64);
+
+    // Returns how many ticks are due after time more units went by
+    std::uint32_t advance(std::uint64_t time);
+    // Drops any pending ticks and partial progress
+    void reset();
+
+    void setRate(std::uint32_t rate);
+    std::uint32_t getRate() const;
+    // Helpers for rates given as floating point ticks per second
+    static std::uint32_t toFixed(double ticksPerSecond);
+    static double fromFixed(std::uint32_t rate);
+};
+
+#endif
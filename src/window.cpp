@@ -11,9 +11,12 @@
 
 #include "window.hpp"
 
-Window::Window()
+Window::Window(std::uint16_t boardW, std::uint16_t boardH, std::uint32_t bots)
 {
     this->pWindowManager = new SGL_Window();
+    pBoardW = boardW;
+    pBoardH = boardH;
+    pBots = bots;
     //seed RNG
     srand(time(NULL));
 }
@@ -126,7 +129,25 @@ void Window::mainLoop()
     pDebugPanelBackground->resetUVCoords();
 
     uint8_t tileSize = 16;
-    pGameGrid = std::make_shared<Grid>(0, 0, (pWindowManager->getWindowCreationSpecs().internalW / tileSize), (pWindowManager->getWindowCreationSpecs().internalH / tileSize), tileSize, SGL_Color(1.0, 1.0, 1.0, 1.0), pWindowManager->assetManager->getTexture("snake_ui"));
+    // The board fills the screen unless told otherwise, larger ones scroll with the snake
+    int boardW = (pBoardW > 0) ? pBoardW : (pWindowManager->getWindowCreationSpecs().internalW / tileSize);
+    int boardH = (pBoardH > 0) ? pBoardH : (pWindowManager->getWindowCreationSpecs().internalH / tileSize);
+    pGameGrid = std::make_shared<Grid>(0, 0, boardW, boardH, tileSize, SGL_Color(1.0, 1.0, 1.0, 1.0), pWindowManager->assetManager->getTexture("snake_ui"));
+    if (pBots > 0)
+    {
+        try
+        {
+            pGameGrid->setBots(pBots, POLICY::GREEDY);
+        }
+        catch (const std::invalid_argument &e)
+        {
+            SGL_Log(std::string("Playing without bots: ") + e.what());
+            pBots = 0;
+        }
+    }
+    // Pick up where the last session left off, the snapshot is only there if it ended mid game
+    if (!pGameGrid->hasBots() && pGameGrid->loadSnapshot("session.snks"))
+        SGL_Log("Resumed the last session");
 
 
     //random number generator (thanks C++11)
@@ -224,9 +245,14 @@ void Window::update(GAME_STATE gameState)
     {
         // pm->update(pDeltaTimeMS, player1->getHitBox().quadX, player1->getHitBox().quadY, player1->getSprite().rotation, 1);
         // pPM->update(pDeltaTimeMS);
-        if (!pGameGrid->update())
+        glm::vec2 mouse = pWindowManager->screenToWorld(glm::vec2(pDeltaInput.mouse.cursorXNormalized, pDeltaInput.mouse.cursorYNormalized));
+        if (!pGameGrid->update(mouse.x, mouse.y))
         {
             pGameState = GAME_STATE::GAME_OVER;
+            remove("session.snks");
+            // Play it back with snake-sgl --replay last_game.snkr
+            if (!pGameGrid->hasBots() && !pGameGrid->saveReplay("last_game.snkr"))
+                SGL_Log("Failed to save the replay");
         }
 
     }
@@ -234,11 +260,11 @@ void Window::update(GAME_STATE gameState)
     // ------------- //
     // UPDATE CAMERA //
     // ------------- //
-    //position the center of the camera on the center of the FBO texture (which has a size of internalW x interalH)
-    this->pWindowManager->setCameraPosition(glm::vec2(pWindowManager->getWindowCreationSpecs().internalW / 2, pWindowManager->getWindowCreationSpecs().internalH / 2));
-    // this->pWindowManager->cameraPosition(pPlayerOne->center());
     //zoom
     this->pWindowManager->setCameraScale(pCameraZoom);
+    // Follow the snake, boards that fit the screen stay centered on the FBO texture (which has a size of internalW x interalH)
+    glm::vec4 viewport = this->pWindowManager->getCameraViewport();
+    this->pWindowManager->setCameraPosition(pGameGrid->getFollowPosition(viewport.z, viewport.w));
     //update the internal offset matrix for rendering
     this->pWindowManager->updateCamera();
 
@@ -340,7 +366,11 @@ void Window::input(GAME_STATE gameState)
     case GAME_STATE::IN_GAME:
     {
         if (desiredKeys.esc.pressed && !pDeltaInput.esc.pressed)
+        {
             pGameState = GAME_STATE::GAME_PAUSED;
+            if (!pGameGrid->hasBots() && !pGameGrid->saveSnapshot("session.snks"))
+                SGL_Log("Failed to save the session");
+        }
 
         // Send input to the player
         //player1->input(desiredKeys);
@@ -355,6 +385,14 @@ void Window::input(GAME_STATE gameState)
         if (desiredKeys.mouse.leftBtn.pressed)
             pMouseLeftHeld = false;
 
+        // A toggles the autopilot
+        if (desiredKeys.a.pressed && !pDeltaInput.a.pressed)
+            pGameGrid->setAutopilot(!pGameGrid->getAutopilot());
+
+        // Hold space to fast forward, backspace to play backwards
+        pGameGrid->setSpeed(Grid::DEFAULT_SPEED * (desiredKeys.space.pressed ? 4 : 1));
+        pGameGrid->setRewinding(desiredKeys.backspace.pressed);
+
         if (desiredKeys.up.pressed && !pDeltaInput.up.pressed)
             pGameGrid->moveSnake(DIRECTION::UP);
         if (desiredKeys.down.pressed && !pDeltaInput.down.pressed)
@@ -395,6 +433,9 @@ void Window::input(GAME_STATE gameState)
             pGameGrid->resetGame();
             pGameState = GAME_STATE::IN_GAME;
         }
+        // Backspace takes the fatal move back, holding it keeps rewinding
+        if (desiredKeys.backspace.pressed && !pDeltaInput.backspace.pressed && pGameGrid->rewind())
+            pGameState = GAME_STATE::IN_GAME;
         break;
     }
     } // switch end
@@ -663,7 +704,10 @@ void Window::renderGame(bool paused)
 {
     SGL_Bitmap_Text text;
 
-    pGameGrid->render(*pWindowManager->renderer.get(), *pWindowManager->assetManager.get());
+    // The board can be thousands of sprites off one sheet, queued they go out in a handful of draws
+    pWindowManager->renderer->setDeferred(true);
+    pGameGrid->render(*pWindowManager->renderer.get(), *pWindowManager->assetManager.get(), pWindowManager->getCameraViewport());
+    pWindowManager->renderer->setDeferred(false);
     if (paused)
     {
         SGL_Sprite darkenBG;
@@ -988,6 +1032,14 @@ void Window::drawDebugPanel(float x, float y, float fontSize, SGL_Color color)
     pWindowManager->renderer->renderText(isFullscreen, center, y + (offset * 5.0f), fontSize, color);
     pWindowManager->renderer->renderText(VSYNC, center, y + (offset * 6.0f), fontSize, color);
     pWindowManager->renderer->renderText("FPS: " + std::to_string(pFPS), center, y + (offset * 7.0f), fontSize, color);
+    // Last frame, the unbatched figure is what drawing every queued sprite on its own would take
+    const SGL_RenderStats &stats = pWindowManager->renderer->getFrameStats();
+    pWindowManager->renderer->renderText("Draw calls: " + std::to_string(stats.drawCalls) + " (unbatched " +
+                                         std::to_string(stats.unbatchedDrawCalls()) + ")", center, y + (offset * 8.0f), fontSize, color);
+    pWindowManager->renderer->renderText("Sprites: " + std::to_string(stats.sprites) + ", " + std::to_string(stats.queuedSprites) +
+                                         " queued in " + std::to_string(stats.batches) + " batches", center, y + (offset * 9.0f), fontSize, color);
+    pWindowManager->renderer->renderText("GL state: " + std::to_string(stats.stateCallsIssued) + " set, " +
+                                         std::to_string(stats.stateCallsElided) + " skipped", center, y + (offset * 10.0f), fontSize, color);
 
 
     // Right
@@ -1139,7 +1191,8 @@ void Window::loadAssets()
     pWindowManager->checkForErrors();
     SGL_Log("Loading 2D textures.");
 
-    pWindowManager->assetManager->loadTexture("assets/textures/snake_ui.png", true, "snake_ui");
+    // The sprite sheet goes in the same atlas page as SGL's font and blank square
+    pWindowManager->assetManager->loadTexture("assets/textures/snake_ui.png", true, "snake_ui", true);
     pWindowManager->assetManager->loadTexture("assets/textures/risk_vector.png", true, "risk_vector");
     pWindowManager->assetManager->loadTexture("assets/textures/bg_space2.png", true, "bg_space");
     pWindowManager->assetManager->loadTexture("assets/textures/splash_screen.jpg", false, "splashScreen");
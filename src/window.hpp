@@ -113,6 +113,8 @@ private:
 
     SGL_Bitmap_Text pBMPText;
     std::shared_ptr<Grid>pGameGrid;
+    std::uint16_t pBoardW, pBoardH; // In tiles, 0 fits the board to the screen
+    std::uint32_t pBots;            // Greedy snakes sharing the board with the player
 
     //required UI sprites
     std::shared_ptr<SGL_Sprite>pUISprite, pDebugPanelBackground,
@@ -131,7 +133,8 @@ private:
 
 public:
 
-    Window();
+    // Board size in tiles, 0 fits it to the screen
+    Window(std::uint16_t boardW = 0, std::uint16_t boardH = 0, std::uint32_t bots = 0);
     ~Window();
 
     int createSGLWindow();